@@ -0,0 +1,334 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "czm_face/czm_face.hpp"
+#include "czm_face/face_inside_tester.hpp"
+#include "czm_face/point_stream.hpp"
+#include "czm_face/synthetic_mesh.hpp"
+
+// Microbenchmarks of the czm_face hot paths. Every benchmark runs over a set
+// of faces and is parameterized by face count and shape (0 = triangle,
+// 1 = quad), plus a density where the operation has one. Results are written
+// as JSON with
+//
+//   czm_face_bench --benchmark_out=czm_face_bench.json --benchmark_out_format=json
+
+namespace
+{
+    using czm_face::CzmFace;
+    using czm_face::CZM_Point;
+    using czm_face::EqualAreaOptions;
+    using czm_face::EqualAreaSelection;
+    using czm_face::PointGenerationMethod;
+
+    // Vertices of count faces on a jittered unit lattice in the z = 0 plane,
+    // slightly tilted; quads are convex. Same faces on every run.
+    std::vector<std::vector<Vec3D>> makeFaceVertices(int count, bool quad)
+    {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> jitter(-0.15, 0.15);
+        int columns = 1;
+        while (columns * columns < count)
+            ++columns;
+
+        std::vector<std::vector<Vec3D>> faces(count);
+        for (int f = 0; f < count; ++f)
+        {
+            double x = f % columns, y = f / columns;
+            faces[f] = {Vec3D(x + jitter(generator), y + jitter(generator), 0.1 * jitter(generator)),
+                        Vec3D(x + 1 + jitter(generator), y + jitter(generator), 0.1 * jitter(generator)),
+                        Vec3D(x + 1 + jitter(generator), y + 1 + jitter(generator), 0.1 * jitter(generator))};
+            if (quad)
+                faces[f].push_back(Vec3D(x + jitter(generator), y + 1 + jitter(generator), 0.1 * jitter(generator)));
+        }
+        return faces;
+    }
+
+    std::vector<CzmFace> makeFaces(int count, bool quad)
+    {
+        std::vector<CzmFace> faces(count);
+        auto vertices = makeFaceVertices(count, quad);
+        for (int f = 0; f < count; ++f)
+            faces[f].createFace(vertices[f]);
+        return faces;
+    }
+
+    // Face counts and shapes shared by all benchmarks
+    void faceArguments(benchmark::internal::Benchmark *benchmark)
+    {
+        benchmark->ArgNames({"faces", "quad"});
+        for (int count : {1, 1024, 65536})
+            for (int quad : {0, 1})
+                benchmark->Args({count, quad});
+    }
+
+    // Face counts and shapes with a density per face
+    void densityArguments(benchmark::internal::Benchmark *benchmark, std::initializer_list<int> densities)
+    {
+        benchmark->ArgNames({"faces", "quad", "density"});
+        for (int count : {1, 1024})
+            for (int quad : {0, 1})
+                for (int density : densities)
+                    benchmark->Args({count, quad, density});
+    }
+
+    void BM_CreateFace(benchmark::State &state)
+    {
+        auto vertices = makeFaceVertices(static_cast<int>(state.range(0)), state.range(1) != 0);
+        for (auto _ : state)
+        {
+            for (const auto &face : vertices)
+            {
+                CzmFace created;
+                benchmark::DoNotOptimize(created.createFace(face));
+                benchmark::DoNotOptimize(created);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CreateFace)->Apply(faceArguments);
+
+    // Synthetic meshes streamed into a face set, up to 10^6 faces; bytes
+    // processed are the face set's coordinate and offset storage
+    void BM_SyntheticMesh(benchmark::State &state)
+    {
+        czm_face::SyntheticMeshOptions options;
+        options.kind = static_cast<czm_face::SyntheticMeshKind>(state.range(1));
+        options.numFaces = static_cast<std::size_t>(state.range(0));
+        options.normal = Vec3D(1, 2, 3);
+        czm_face::SyntheticMesh mesh(options);
+        for (auto _ : state)
+        {
+            czm_face::CzmFaceSet faces;
+            mesh.appendTo(faces);
+            benchmark::DoNotOptimize(faces.getX().data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                (mesh.getVerticesPerFace() * 3 * sizeof(double) + sizeof(std::size_t)));
+    }
+    BENCHMARK(BM_SyntheticMesh)->ArgNames({"faces", "kind"})->ArgsProduct({{1000, 100000, 1000000}, {0, 1, 2, 3}});
+
+    // Derived geometry is cached on the face; the Cached benchmarks measure
+    // the queries callers make, Refresh the recomputation after a vertex update
+
+    void BM_CalculateAreaCached(benchmark::State &state)
+    {
+        auto faces = makeFaces(static_cast<int>(state.range(0)), state.range(1) != 0);
+        for (auto _ : state)
+        {
+            double total = 0.0;
+            for (const auto &face : faces)
+                total += face.calculateArea();
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CalculateAreaCached)->Apply(faceArguments);
+
+    void BM_GetNormalCached(benchmark::State &state)
+    {
+        auto faces = makeFaces(static_cast<int>(state.range(0)), state.range(1) != 0);
+        for (auto _ : state)
+        {
+            Vec3D total(0, 0, 0);
+            for (const auto &face : faces)
+                total += face.getNormal();
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_GetNormalCached)->Apply(faceArguments);
+
+    void BM_CalculateCenterCached(benchmark::State &state)
+    {
+        auto faces = makeFaces(static_cast<int>(state.range(0)), state.range(1) != 0);
+        for (auto _ : state)
+        {
+            Vec3D total(0, 0, 0);
+            for (const auto &face : faces)
+                total += face.calculateCenter();
+            benchmark::DoNotOptimize(total);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CalculateCenterCached)->Apply(faceArguments);
+
+    void BM_RefreshGeometry(benchmark::State &state)
+    {
+        int count = static_cast<int>(state.range(0));
+        auto faces = makeFaces(count, state.range(1) != 0);
+        auto vertices = makeFaceVertices(count, state.range(1) != 0);
+        for (auto _ : state)
+        {
+            for (int f = 0; f < count; ++f)
+            {
+                faces[f].updateVertices(vertices[f]);
+                faces[f].refreshGeometry();
+            }
+            benchmark::DoNotOptimize(faces.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_RefreshGeometry)->Apply(faceArguments);
+
+    // Points written to a preallocated buffer, so allocation is not measured
+    void BM_GeneratePointGrid(benchmark::State &state, PointGenerationMethod method)
+    {
+        auto faces = makeFaces(static_cast<int>(state.range(0)), state.range(1) != 0);
+        int density = static_cast<int>(state.range(2));
+        std::size_t capacity = 0;
+        for (const auto &face : faces)
+            capacity = std::max(capacity, face.countPoints(density, method));
+        std::vector<CZM_Point> buffer(capacity);
+
+        // Build cached reference patterns before timing
+        faces.front().generatePointGrid(density, method, buffer);
+
+        std::size_t points = 0;
+        for (auto _ : state)
+        {
+            for (const auto &face : faces)
+                points += face.generatePointGrid(density, method, buffer);
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(points));
+        state.counters["points_per_face"] =
+            static_cast<double>(points) / (static_cast<double>(state.iterations()) * state.range(0));
+    }
+
+    // 65 is the first density above ReferencePatternCache::kMaxCachedDensity
+    void gridArguments(benchmark::internal::Benchmark *benchmark) { densityArguments(benchmark, {4, 16, 64, 65}); }
+    void quadratureArguments(benchmark::internal::Benchmark *benchmark) { densityArguments(benchmark, {2, 5, 10}); }
+
+    BENCHMARK_CAPTURE(BM_GeneratePointGrid, EdgeOnly, PointGenerationMethod::EDGE_ONLY)->Apply(gridArguments);
+    BENCHMARK_CAPTURE(BM_GeneratePointGrid, EdgeAndInterior, PointGenerationMethod::EDGE_AND_INTERIOR)->Apply(gridArguments);
+    BENCHMARK_CAPTURE(BM_GeneratePointGrid, InteriorOnly, PointGenerationMethod::INTERIOR_ONLY)->Apply(gridArguments);
+    BENCHMARK_CAPTURE(BM_GeneratePointGrid, UniformGrid, PointGenerationMethod::UNIFORM_GRID)->Apply(gridArguments);
+    BENCHMARK_CAPTURE(BM_GeneratePointGrid, ParametricGrid, PointGenerationMethod::PARAMETRIC_GRID)->Apply(gridArguments);
+    BENCHMARK_CAPTURE(BM_GeneratePointGrid, Gauss, PointGenerationMethod::GAUSS)->Apply(quadratureArguments);
+    BENCHMARK_CAPTURE(BM_GeneratePointGrid, Lobatto, PointGenerationMethod::LOBATTO)->Apply(quadratureArguments);
+
+    // Chunked streaming of a face set, by chunk size
+    void BM_PointStream(benchmark::State &state)
+    {
+        czm_face::SyntheticMeshOptions options;
+        options.numFaces = 16384;
+        czm_face::CzmFaceSet faces;
+        czm_face::SyntheticMesh(options).appendTo(faces);
+
+        std::size_t points = 0;
+        for (auto _ : state)
+        {
+            czm_face::PointStream stream(faces, PointGenerationMethod::PARAMETRIC_GRID, 16,
+                                         static_cast<std::size_t>(state.range(0)));
+            points += stream.forEachChunk([](const czm_face::PointChunk &chunk)
+                                          { benchmark::DoNotOptimize(chunk.points.data()); });
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(points));
+    }
+    BENCHMARK(BM_PointStream)->ArgName("chunk")->Arg(1024)->Arg(65536)->Arg(1 << 20);
+
+    void BM_GenerateEqualAreaPoints(benchmark::State &state, EqualAreaSelection selection)
+    {
+        auto faces = makeFaces(static_cast<int>(state.range(0)), state.range(1) != 0);
+        int numPoints = static_cast<int>(state.range(2));
+        EqualAreaOptions options;
+        options.selection = selection;
+        std::size_t capacity = 0;
+        for (const auto &face : faces)
+            capacity = std::max(capacity, face.countEqualAreaPoints(numPoints, options));
+        std::vector<CZM_Point> buffer(capacity);
+
+        // Build cached centroidal layouts before timing
+        faces.front().generateEqualAreaPoints(numPoints, options, buffer);
+
+        std::size_t points = 0;
+        for (auto _ : state)
+        {
+            for (std::size_t f = 0; f < faces.size(); ++f)
+            {
+                options.faceId = f;
+                points += faces[f].generateEqualAreaPoints(numPoints, options, buffer);
+            }
+            benchmark::DoNotOptimize(buffer.data());
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(points));
+    }
+
+    void equalAreaArguments(benchmark::internal::Benchmark *benchmark) { densityArguments(benchmark, {16, 256}); }
+
+    BENCHMARK_CAPTURE(BM_GenerateEqualAreaPoints, Random, EqualAreaSelection::RANDOM)->Apply(equalAreaArguments);
+    BENCHMARK_CAPTURE(BM_GenerateEqualAreaPoints, Stratified, EqualAreaSelection::STRATIFIED)->Apply(equalAreaArguments);
+    BENCHMARK_CAPTURE(BM_GenerateEqualAreaPoints, Centroidal, EqualAreaSelection::CENTROIDAL)->Apply(equalAreaArguments);
+
+    // Inside tests of density^2 points spread over each face's bounding box.
+    // CzmFace::isPointInside is private; the public tester runs the same test.
+    std::vector<Vec3D> makeQueryPoints(const CzmFace &face, int density)
+    {
+        auto box = face.calculateBoundingBox();
+        std::vector<Vec3D> points;
+        for (int i = 0; i < density; ++i)
+        {
+            for (int j = 0; j < density; ++j)
+            {
+                double s = (i + 0.5) / density, t = (j + 0.5) / density;
+                points.push_back(Vec3D(box.min.comp[0] + s * (box.max.comp[0] - box.min.comp[0]),
+                                       box.min.comp[1] + t * (box.max.comp[1] - box.min.comp[1]),
+                                       0.5 * (box.min.comp[2] + box.max.comp[2])));
+            }
+        }
+        return points;
+    }
+
+    void BM_InsideTestSingle(benchmark::State &state)
+    {
+        auto faces = makeFaces(static_cast<int>(state.range(0)), state.range(1) != 0);
+        int density = static_cast<int>(state.range(2));
+        std::vector<czm_face::FaceInsideTester> testers(faces.begin(), faces.end());
+        std::vector<std::vector<Vec3D>> points;
+        for (const auto &face : faces)
+            points.push_back(makeQueryPoints(face, density));
+
+        for (auto _ : state)
+        {
+            std::size_t inside = 0;
+            for (std::size_t f = 0; f < faces.size(); ++f)
+                for (const auto &point : points[f])
+                    inside += testers[f].contains(point) ? 1 : 0;
+            benchmark::DoNotOptimize(inside);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) * density * density);
+    }
+
+    template <typename Point>
+    void BM_InsideTestBatch(benchmark::State &state)
+    {
+        auto faces = makeFaces(static_cast<int>(state.range(0)), state.range(1) != 0);
+        int density = static_cast<int>(state.range(2));
+        std::vector<czm_face::FaceInsideTester> testers(faces.begin(), faces.end());
+        std::vector<std::vector<Point>> points;
+        for (const auto &face : faces)
+        {
+            points.emplace_back();
+            for (const auto &point : makeQueryPoints(face, density))
+                points.back().push_back(Point(point.comp[0], point.comp[1], point.comp[2]));
+        }
+        std::vector<std::uint64_t> mask((density * density + 63) / 64);
+
+        for (auto _ : state)
+        {
+            std::size_t inside = 0;
+            for (std::size_t f = 0; f < faces.size(); ++f)
+                inside += testers[f].classify(czm_face::Span<const Point>(points[f].data(), points[f].size()), mask);
+            benchmark::DoNotOptimize(inside);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0) * density * density);
+    }
+
+    void insideArguments(benchmark::internal::Benchmark *benchmark) { densityArguments(benchmark, {8, 32}); }
+
+    BENCHMARK(BM_InsideTestSingle)->Apply(insideArguments);
+    BENCHMARK_TEMPLATE(BM_InsideTestBatch, Vec3D)->Apply(insideArguments);
+    BENCHMARK_TEMPLATE(BM_InsideTestBatch, Vec3f)->Apply(insideArguments);
+}
@@ -0,0 +1,327 @@
+#include "binary_format.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CZM_FACE_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace czm_face
+{
+
+    static_assert(sizeof(std::size_t) == sizeof(std::uint64_t),
+                  "Face offsets are mapped in place as std::size_t");
+
+    namespace
+    {
+        constexpr char kMagic[8] = {'C', 'Z', 'M', 'F', 'A', 'C', 'E', '\0'};
+
+        bool isLittleEndian()
+        {
+            const std::uint32_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }
+
+        std::uint64_t alignUp(std::uint64_t offset)
+        {
+            return (offset + kBinaryAlignment - 1) / kBinaryAlignment * kBinaryAlignment;
+        }
+
+        // Array to be written as one section
+        struct SectionData
+        {
+            BinarySectionId id;
+            std::uint32_t elementSize;
+            std::uint64_t count;
+            const void *data;
+        };
+
+        template <typename T>
+        SectionData makeSection(BinarySectionId id, const std::vector<T> &values)
+        {
+            return SectionData{id, sizeof(T), values.size(), values.data()};
+        }
+
+        // Write header, section table and aligned sections in bulk
+        bool writeSections(const std::string &path, BinaryContents contents, std::uint64_t count,
+                           const std::vector<SectionData> &sections)
+        {
+            if (!isLittleEndian())
+                return false;
+
+            std::vector<BinarySection> table(sections.size());
+            std::uint64_t offset = alignUp(sizeof(BinaryHeader) + sections.size() * sizeof(BinarySection));
+            for (std::size_t s = 0; s < sections.size(); ++s)
+            {
+                table[s] = BinarySection{static_cast<std::uint32_t>(sections[s].id), sections[s].elementSize,
+                                         sections[s].count, offset, 0};
+                offset = alignUp(offset + sections[s].count * sections[s].elementSize);
+            }
+
+            BinaryHeader header{};
+            std::memcpy(header.magic, kMagic, sizeof(kMagic));
+            header.version = kBinaryFormatVersion;
+            header.contents = static_cast<std::uint32_t>(contents);
+            header.count = count;
+            header.fileSize = offset;
+            header.numSections = static_cast<std::uint32_t>(sections.size());
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return false;
+
+            static const char padding[kBinaryAlignment] = {};
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(table.data()),
+                       static_cast<std::streamsize>(table.size() * sizeof(BinarySection)));
+            std::uint64_t written = sizeof(header) + table.size() * sizeof(BinarySection);
+            for (std::size_t s = 0; s < sections.size(); ++s)
+            {
+                file.write(padding, static_cast<std::streamsize>(table[s].offset - written));
+                std::uint64_t bytes = sections[s].count * sections[s].elementSize;
+                file.write(static_cast<const char *>(sections[s].data), static_cast<std::streamsize>(bytes));
+                written = table[s].offset + bytes;
+            }
+            file.write(padding, static_cast<std::streamsize>(offset - written));
+            return static_cast<bool>(file.flush());
+        }
+
+        // Check that a face offset array is a valid face layout
+        bool checkFaceOffsets(Span<const std::size_t> offsets, std::size_t numVertices)
+        {
+            if (offsets.empty() || offsets[0] != 0 || offsets[offsets.size() - 1] != numVertices)
+                return false;
+            for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+            {
+                if (offsets[i + 1] < offsets[i] || offsets[i + 1] - offsets[i] < 3 || offsets[i + 1] - offsets[i] > 4)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    bool writeFaceSet(const std::string &path, const CzmFaceSet &faces)
+    {
+        return writeSections(path, BinaryContents::FACE_SET, faces.size(),
+                             {makeSection(BinarySectionId::X, faces.getX()),
+                              makeSection(BinarySectionId::Y, faces.getY()),
+                              makeSection(BinarySectionId::Z, faces.getZ()),
+                              makeSection(BinarySectionId::FACE_OFFSETS, faces.getOffsets())});
+    }
+
+    bool writePointCloud(const std::string &path, const CzmPointCloud &points)
+    {
+        return writeSections(path, BinaryContents::POINT_CLOUD, points.size(),
+                             {makeSection(BinarySectionId::X, points.getX()),
+                              makeSection(BinarySectionId::Y, points.getY()),
+                              makeSection(BinarySectionId::Z, points.getZ()),
+                              makeSection(BinarySectionId::TYPE_BITS, points.getTypeBits()),
+                              makeSection(BinarySectionId::FACE_IDS, points.getFaceIds()),
+                              makeSection(BinarySectionId::EDGE_INDICES, points.getEdgeIndices())});
+    }
+
+    bool readFaceSet(const std::string &path, CzmFaceSet &faces)
+    {
+        BinaryFile file;
+        if (!file.open(path) || file.getContents() != BinaryContents::FACE_SET)
+            return false;
+        return faces.assign(file.getSection<double>(BinarySectionId::X), file.getSection<double>(BinarySectionId::Y),
+                            file.getSection<double>(BinarySectionId::Z),
+                            file.getSection<std::size_t>(BinarySectionId::FACE_OFFSETS));
+    }
+
+    bool readPointCloud(const std::string &path, CzmPointCloud &points)
+    {
+        BinaryFile file;
+        if (!file.open(path) || file.getContents() != BinaryContents::POINT_CLOUD)
+            return false;
+        return points.assign(file.getSection<double>(BinarySectionId::X), file.getSection<double>(BinarySectionId::Y),
+                             file.getSection<double>(BinarySectionId::Z),
+                             file.getSection<std::uint64_t>(BinarySectionId::TYPE_BITS),
+                             file.getSection<std::uint32_t>(BinarySectionId::FACE_IDS),
+                             file.getSection<std::int8_t>(BinarySectionId::EDGE_INDICES));
+    }
+
+    BinaryFile::~BinaryFile()
+    {
+        close();
+    }
+
+    BinaryFile::BinaryFile(BinaryFile &&other) noexcept
+        : data_(other.data_), size_(other.size_), mapped_(other.mapped_)
+    {
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+
+    BinaryFile &BinaryFile::operator=(BinaryFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(mapped_, other.mapped_);
+        }
+        return *this;
+    }
+
+    bool BinaryFile::open(const std::string &path)
+    {
+        close();
+        if (!isLittleEndian())
+            return false;
+
+#ifdef CZM_FACE_HAVE_MMAP
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            return false;
+        struct stat status;
+        if (::fstat(descriptor, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(BinaryHeader)))
+        {
+            ::close(descriptor);
+            return false;
+        }
+        size_ = static_cast<std::size_t>(status.st_size);
+        void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        ::close(descriptor);
+        if (mapping == MAP_FAILED)
+        {
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const unsigned char *>(mapping);
+        mapped_ = true;
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+        size_ = static_cast<std::size_t>(file.tellg());
+        if (size_ < sizeof(BinaryHeader))
+            return false;
+        void *buffer = ::operator new(size_, std::align_val_t(kBinaryAlignment));
+        file.seekg(0);
+        if (!file.read(static_cast<char *>(buffer), static_cast<std::streamsize>(size_)))
+        {
+            ::operator delete(buffer, std::align_val_t(kBinaryAlignment));
+            return false;
+        }
+        data_ = static_cast<const unsigned char *>(buffer);
+        mapped_ = false;
+#endif
+
+        // Header and section table
+        const BinaryHeader &header = getHeader();
+        bool valid = std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+                     header.version == kBinaryFormatVersion && header.fileSize == size_ &&
+                     (header.contents == static_cast<std::uint32_t>(BinaryContents::FACE_SET) ||
+                      header.contents == static_cast<std::uint32_t>(BinaryContents::POINT_CLOUD)) &&
+                     header.numSections <= (size_ - sizeof(BinaryHeader)) / sizeof(BinarySection);
+        for (std::uint32_t s = 0; valid && s < header.numSections; ++s)
+        {
+            const BinarySection &section = reinterpret_cast<const BinarySection *>(data_ + sizeof(BinaryHeader))[s];
+            valid = section.offset % kBinaryAlignment == 0 && section.offset <= size_ && section.elementSize > 0 &&
+                    section.count <= (size_ - section.offset) / section.elementSize;
+        }
+
+        // Array sizes of the contents
+        std::size_t count = valid ? size() : 0;
+        if (valid && getContents() == BinaryContents::FACE_SET)
+        {
+            auto x = getSection<double>(BinarySectionId::X);
+            valid = getSection<double>(BinarySectionId::Y).size() == x.size() &&
+                    getSection<double>(BinarySectionId::Z).size() == x.size() &&
+                    getSection<std::size_t>(BinarySectionId::FACE_OFFSETS).size() == count + 1 &&
+                    checkFaceOffsets(getSection<std::size_t>(BinarySectionId::FACE_OFFSETS), x.size());
+        }
+        else if (valid)
+        {
+            valid = getSection<double>(BinarySectionId::X).size() == count &&
+                    getSection<double>(BinarySectionId::Y).size() == count &&
+                    getSection<double>(BinarySectionId::Z).size() == count &&
+                    getSection<std::uint64_t>(BinarySectionId::TYPE_BITS).size() == (count + 63) / 64 &&
+                    getSection<std::uint32_t>(BinarySectionId::FACE_IDS).size() == count &&
+                    getSection<std::int8_t>(BinarySectionId::EDGE_INDICES).size() == count;
+        }
+
+        if (!valid)
+            close();
+        return valid;
+    }
+
+    void BinaryFile::close()
+    {
+        if (!data_)
+            return;
+#ifdef CZM_FACE_HAVE_MMAP
+        if (mapped_)
+            ::munmap(const_cast<unsigned char *>(data_), size_);
+#endif
+        if (!mapped_)
+            ::operator delete(const_cast<unsigned char *>(data_), std::align_val_t(kBinaryAlignment));
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+    }
+
+    const BinaryHeader &BinaryFile::getHeader() const
+    {
+        static const BinaryHeader closed{};
+        return isOpen() ? *reinterpret_cast<const BinaryHeader *>(data_) : closed;
+    }
+
+    FaceGeometryView BinaryFile::getFaceView() const
+    {
+        FaceGeometryView view;
+        if (!isOpen() || getContents() != BinaryContents::FACE_SET)
+            return view;
+        view.x = getSection<double>(BinarySectionId::X).data();
+        view.y = getSection<double>(BinarySectionId::Y).data();
+        view.z = getSection<double>(BinarySectionId::Z).data();
+        view.offsets = getSection<std::size_t>(BinarySectionId::FACE_OFFSETS).data();
+        view.numFaces = size();
+        return view;
+    }
+
+    CzmFace BinaryFile::getFace(std::size_t face) const
+    {
+        FaceGeometryView view = getFaceView();
+        if (face >= view.numFaces)
+            return CzmFace();
+
+        Vec3D vertices[CzmFace::kMaxVertices];
+        std::size_t count = view.offsets[face + 1] - view.offsets[face];
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            std::size_t index = view.offsets[face] + k;
+            vertices[k] = Vec3D(view.x[index], view.y[index], view.z[index]);
+        }
+
+        CzmFace result;
+        result.createFace(vertices, count);
+        return result;
+    }
+
+    const BinarySection *BinaryFile::findSection(BinarySectionId id) const
+    {
+        if (!isOpen())
+            return nullptr;
+        const auto *table = reinterpret_cast<const BinarySection *>(data_ + sizeof(BinaryHeader));
+        for (std::uint32_t s = 0; s < getHeader().numSections; ++s)
+        {
+            if (table[s].id == static_cast<std::uint32_t>(id))
+                return &table[s];
+        }
+        return nullptr;
+    }
+
+} // namespace czm_face
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "czm_face.hpp"
+#include "czm_face_set.hpp"
+#include "czm_point_cloud.hpp"
+#include "face_kernels.hpp"
+#include "span.hpp"
+
+namespace czm_face
+{
+
+    // Binary file format for face sets and point clouds, laid out so a file
+    // can be memory-mapped and its arrays used in place. All values are
+    // little-endian. The file starts with a 64-byte header followed by a
+    // table of sections; every section holds one contiguous array and
+    // starts at a multiple of 64 bytes.
+    //
+    //   Face set:    X, Y, Z (double per vertex), FACE_OFFSETS (uint64, faces + 1)
+    //   Point cloud: X, Y, Z (double per point), TYPE_BITS (uint64, bit i set for
+    //                edge points), FACE_IDS (uint32), EDGE_INDICES (int8)
+    //
+    // Readers accept only files of exactly their own version and ignore
+    // sections they do not know. Only little-endian 64-bit hosts are supported; the
+    // functions below return false elsewhere.
+
+    constexpr std::uint32_t kBinaryFormatVersion = 1;
+    constexpr std::size_t kBinaryAlignment = 64;
+
+    enum class BinaryContents : std::uint32_t
+    {
+        FACE_SET = 1,
+        POINT_CLOUD = 2
+    };
+
+    enum class BinarySectionId : std::uint32_t
+    {
+        X = 1,
+        Y = 2,
+        Z = 3,
+        FACE_OFFSETS = 4,
+        TYPE_BITS = 5,
+        FACE_IDS = 6,
+        EDGE_INDICES = 7
+    };
+
+    // File header (64 bytes at offset 0)
+    struct BinaryHeader
+    {
+        char magic[8];              // "CZMFACE" and a zero byte
+        std::uint32_t version;      // kBinaryFormatVersion
+        std::uint32_t contents;     // BinaryContents
+        std::uint64_t count;        // Number of faces or points
+        std::uint64_t fileSize;     // Total file size in bytes
+        std::uint32_t numSections;  // Entries of the section table
+        std::uint32_t reserved[7];  // Zero
+    };
+
+    // Section table entry (32 bytes, table starts at offset 64)
+    struct BinarySection
+    {
+        std::uint32_t id;          // BinarySectionId
+        std::uint32_t elementSize; // Bytes per element
+        std::uint64_t count;       // Number of elements
+        std::uint64_t offset;      // Byte offset of the data, a multiple of 64
+        std::uint64_t reserved;    // Zero
+    };
+
+    static_assert(sizeof(BinaryHeader) == 64, "BinaryHeader must be 64 bytes");
+    static_assert(sizeof(BinarySection) == 32, "BinarySection must be 32 bytes");
+
+    // Write a face set or point cloud; returns false on I/O errors
+    bool writeFaceSet(const std::string &path, const CzmFaceSet &faces);
+    bool writePointCloud(const std::string &path, const CzmPointCloud &points);
+
+    // Read a file into a container (a copy; see BinaryFile for zero-copy use)
+    bool readFaceSet(const std::string &path, CzmFaceSet &faces);
+    bool readPointCloud(const std::string &path, CzmPointCloud &points);
+
+    // Read-only memory mapping of a validated binary file. Sections are
+    // returned as views into the mapping, valid while the file stays open.
+    // Where memory mapping is unavailable the file is read into an aligned
+    // buffer instead.
+    class BinaryFile
+    {
+    public:
+        BinaryFile() = default;
+        ~BinaryFile();
+
+        // Prevent copying (the mapping is owned)
+        BinaryFile(const BinaryFile &) = delete;
+        BinaryFile &operator=(const BinaryFile &) = delete;
+
+        // Allow moving
+        BinaryFile(BinaryFile &&other) noexcept;
+        BinaryFile &operator=(BinaryFile &&other) noexcept;
+
+        // Map a file and check its header, section table and array sizes;
+        // returns false (and stays closed) for missing, truncated or foreign files
+        bool open(const std::string &path);
+
+        // Unmap the file
+        void close();
+
+        // Check if a file is open
+        bool isOpen() const { return data_ != nullptr; }
+
+        // Get the header of the open file; a zeroed header (no contents, no
+        // elements) if no file is open
+        const BinaryHeader &getHeader() const;
+        BinaryContents getContents() const { return static_cast<BinaryContents>(getHeader().contents); }
+        std::size_t size() const { return static_cast<std::size_t>(getHeader().count); }
+
+        // Get a section as an array of T; empty if it is missing or its
+        // element size differs from sizeof(T)
+        template <typename T>
+        Span<const T> getSection(BinarySectionId id) const
+        {
+            const BinarySection *section = findSection(id);
+            if (!section || section->elementSize != sizeof(T))
+                return Span<const T>();
+            return Span<const T>(reinterpret_cast<const T *>(data_ + section->offset),
+                                 static_cast<std::size_t>(section->count));
+        }
+
+        // Face set files: view for the batch kernels, and single faces. The
+        // view is empty and faces are empty (no vertices) if the file is not
+        // an open face set or the index is out of range.
+        FaceGeometryView getFaceView() const;
+        CzmFace getFace(std::size_t face) const;
+
+    private:
+        const BinarySection *findSection(BinarySectionId id) const;
+
+        const unsigned char *data_ = nullptr; // Mapped file contents
+        std::size_t size_ = 0;                // Mapped size in bytes
+        bool mapped_ = false;                 // Memory-mapped (else heap buffer)
+    };
+
+} // namespace czm_face
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include "vec3d/vec3d.h"
+
+namespace czm_face
+{
+
+    // Axis-aligned bounding box. A default constructed box is empty (min > max)
+    // and becomes valid once a point is added.
+    struct BoundingBox
+    {
+        Vec3D min = Vec3D(std::numeric_limits<double>::max(),
+                          std::numeric_limits<double>::max(),
+                          std::numeric_limits<double>::max());
+        Vec3D max = Vec3D(std::numeric_limits<double>::lowest(),
+                          std::numeric_limits<double>::lowest(),
+                          std::numeric_limits<double>::lowest());
+
+        // Check if no point has been added
+        bool isEmpty() const { return min.comp[0] > max.comp[0]; }
+
+        // Grow the box to include a point or another box
+        void expand(const Vec3D &point)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                min.comp[k] = std::min(min.comp[k], point.comp[k]);
+                max.comp[k] = std::max(max.comp[k], point.comp[k]);
+            }
+        }
+
+        void expand(const BoundingBox &box)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                min.comp[k] = std::min(min.comp[k], box.min.comp[k]);
+                max.comp[k] = std::max(max.comp[k], box.max.comp[k]);
+            }
+        }
+
+        // Grow the box by a margin on every side
+        void inflate(double margin)
+        {
+            min -= margin;
+            max += margin;
+        }
+
+        // Get box center
+        Vec3D getCenter() const { return 0.5 * (min + max); }
+
+        // Get box extent along each axis
+        Vec3D getExtent() const { return max - min; }
+
+        // Get surface area (0 for empty boxes)
+        double getSurfaceArea() const
+        {
+            if (isEmpty())
+                return 0.0;
+            Vec3D d = getExtent();
+            return 2.0 * (d.comp[0] * d.comp[1] + d.comp[1] * d.comp[2] + d.comp[2] * d.comp[0]);
+        }
+
+        // Check if a point lies inside or on the box
+        bool contains(const Vec3D &point) const
+        {
+            return point.comp[0] >= min.comp[0] && point.comp[0] <= max.comp[0] &&
+                   point.comp[1] >= min.comp[1] && point.comp[1] <= max.comp[1] &&
+                   point.comp[2] >= min.comp[2] && point.comp[2] <= max.comp[2];
+        }
+
+        // Check if two boxes intersect (touching counts)
+        bool overlaps(const BoundingBox &box) const
+        {
+            return min.comp[0] <= box.max.comp[0] && max.comp[0] >= box.min.comp[0] &&
+                   min.comp[1] <= box.max.comp[1] && max.comp[1] >= box.min.comp[1] &&
+                   min.comp[2] <= box.max.comp[2] && max.comp[2] >= box.min.comp[2];
+        }
+
+        // Squared distance from a point to the box (0 inside)
+        double squaredDistance(const Vec3D &point) const
+        {
+            double distance = 0.0;
+            for (int k = 0; k < 3; ++k)
+            {
+                double d = std::max({min.comp[k] - point.comp[k], 0.0, point.comp[k] - max.comp[k]});
+                distance += d * d;
+            }
+            return distance;
+        }
+    };
+
+} // namespace czm_face
@@ -0,0 +1,352 @@
+#include "centroidal_layout.hpp"
+#include "polygon2d.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        // Number of step pairs the quasi-Newton update remembers
+        constexpr int kHistory = 7;
+
+        // Sufficient decrease of the energy along a step (Armijo)
+        constexpr double kArmijo = 1e-4;
+
+        // Halvings of a quasi-Newton step before falling back to Lloyd
+        constexpr int kMaxBacktracks = 8;
+
+        double radicalInverse(int index, int base)
+        {
+            double inverse = 0.0;
+            double scale = 1.0 / base;
+            for (; index > 0; index /= base, scale /= base)
+            {
+                inverse += (index % base) * scale;
+            }
+            return inverse;
+        }
+
+        Polygon2 referencePolygon(ReferenceShape shape)
+        {
+            if (shape == ReferenceShape::TRIANGLE)
+                return {{0.0, 0.0}, {1.0, 0.0}, {0.0, 1.0}};
+            return {{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}};
+        }
+
+        bool isInside(ReferenceShape shape, const Point2 &p)
+        {
+            if (p.x < 0.0 || p.y < 0.0)
+                return false;
+            return (shape == ReferenceShape::TRIANGLE) ? p.x + p.y <= 1.0 : (p.x <= 1.0 && p.y <= 1.0);
+        }
+
+        double dot(const std::vector<Point2> &a, const std::vector<Point2> &b)
+        {
+            double sum = 0.0;
+            for (std::size_t i = 0; i < a.size(); ++i)
+                sum += a[i].x * b[i].x + a[i].y * b[i].y;
+            return sum;
+        }
+
+        // Voronoi cells of generators clipped to a reference shape. Generators
+        // are bucketed in a grid of about one per bucket, so the neighbours of
+        // a cell are found by searching rings of buckets.
+        class VoronoiCells
+        {
+        public:
+            VoronoiCells(ReferenceShape shape, int count)
+                : domain_(referencePolygon(shape)), count_(count),
+                  gridSize_(std::max(1, static_cast<int>(std::sqrt(static_cast<double>(count))))),
+                  bucketOffsets_(gridSize_ * gridSize_ + 1), bucketGenerators_(count), generatorBucket_(count)
+            {
+            }
+
+            // Compute the centroid and area of every cell; returns the CVT
+            // energy, the sum of the second moments of the cells about their
+            // generators
+            double evaluate(const std::vector<Point2> &generators, std::vector<Point2> &centroids,
+                            std::vector<double> &areas)
+            {
+                std::fill(bucketOffsets_.begin(), bucketOffsets_.end(), 0);
+                for (int i = 0; i < count_; ++i)
+                {
+                    generatorBucket_[i] = bucketCoordinate(generators[i].y) * gridSize_ + bucketCoordinate(generators[i].x);
+                    ++bucketOffsets_[generatorBucket_[i] + 1];
+                }
+                for (int b = 0; b < gridSize_ * gridSize_; ++b)
+                    bucketOffsets_[b + 1] += bucketOffsets_[b];
+                std::vector<int> cursor(bucketOffsets_.begin(), bucketOffsets_.end() - 1);
+                for (int i = 0; i < count_; ++i)
+                    bucketGenerators_[cursor[generatorBucket_[i]]++] = i;
+
+                const double bucketSize = 1.0 / gridSize_;
+                double energy = 0.0;
+                for (int i = 0; i < count_; ++i)
+                {
+                    const Point2 &g = generators[i];
+                    int bx = generatorBucket_[i] % gridSize_;
+                    int by = generatorBucket_[i] / gridSize_;
+
+                    // Clip by bisectors ring by ring; generators beyond ring r
+                    // are at least r buckets away, so stop once that exceeds
+                    // twice the cell radius
+                    cell_ = domain_;
+                    for (int ring = 0; ring < gridSize_; ++ring)
+                    {
+                        for (int y = std::max(0, by - ring); y <= std::min(gridSize_ - 1, by + ring); ++y)
+                        {
+                            for (int x = std::max(0, bx - ring); x <= std::min(gridSize_ - 1, bx + ring); ++x)
+                            {
+                                if (std::max(std::abs(x - bx), std::abs(y - by)) != ring)
+                                    continue;
+
+                                int bucket = y * gridSize_ + x;
+                                for (int n = bucketOffsets_[bucket]; n < bucketOffsets_[bucket + 1]; ++n)
+                                {
+                                    int j = bucketGenerators_[n];
+                                    if (j == i)
+                                        continue;
+
+                                    const Point2 &h = generators[j];
+                                    double nx = h.x - g.x, ny = h.y - g.y;
+                                    double c = 0.5 * (h.x * h.x + h.y * h.y - g.x * g.x - g.y * g.y);
+                                    clipPolygon(cell_, nx, ny, c, clipped_);
+                                    cell_.swap(clipped_);
+                                }
+                            }
+                        }
+
+                        double radius2 = 0.0;
+                        for (const Point2 &p : cell_)
+                            radius2 = std::max(radius2, (p.x - g.x) * (p.x - g.x) + (p.y - g.y) * (p.y - g.y));
+                        double reach = ring * bucketSize;
+                        if (reach * reach > 4.0 * radius2)
+                            break;
+                    }
+                    areas[i] = polygonAreaCentroid(cell_, centroids[i]);
+                    energy += polygonSecondMoment(cell_, g);
+                }
+                return energy;
+            }
+
+        private:
+            int bucketCoordinate(double value) const
+            {
+                return std::min(gridSize_ - 1, std::max(0, static_cast<int>(value * gridSize_)));
+            }
+
+            Polygon2 domain_;
+            int count_;
+            int gridSize_;
+            std::vector<int> bucketOffsets_;
+            std::vector<int> bucketGenerators_;
+            std::vector<int> generatorBucket_;
+            Polygon2 cell_, clipped_;
+        };
+    }
+
+    CentroidalLayout computeCentroidalLayout(ReferenceShape shape, int count, int maxIterations, double tolerance)
+    {
+        CentroidalLayout layout;
+        if (count <= 0)
+            return layout;
+
+        // Halton starting points; the triangle rejects points outside of it
+        // (folding them in could make two generators coincide)
+        std::vector<Point2> generators;
+        generators.reserve(count);
+        for (int index = 1; static_cast<int>(generators.size()) < count; ++index)
+        {
+            double s = radicalInverse(index, 2);
+            double t = radicalInverse(index, 3);
+            if (shape == ReferenceShape::QUAD || s + t < 1.0)
+                generators.push_back(Point2{s, t});
+        }
+
+        VoronoiCells cells(shape, count);
+        std::vector<Point2> centroids(count), trialCentroids(count);
+        std::vector<double> areas(count), trialAreas(count);
+        double energy = cells.evaluate(generators, centroids, areas);
+
+        // The energy gradient of generator i is 2 area_i (g_i - c_i); a Lloyd
+        // step moves every generator to its centroid
+        std::vector<Point2> gradient(count), direction(count), trial(count), trialGradient(count);
+        auto computeGradient = [count](const std::vector<Point2> &points, const std::vector<Point2> &cellCentroids,
+                                       const std::vector<double> &cellAreas, std::vector<Point2> &result)
+        {
+            for (int i = 0; i < count; ++i)
+                result[i] = Point2{2.0 * cellAreas[i] * (points[i].x - cellCentroids[i].x),
+                                   2.0 * cellAreas[i] * (points[i].y - cellCentroids[i].y)};
+        };
+        computeGradient(generators, centroids, areas, gradient);
+
+        // L-BFGS on the energy: plain Lloyd iteration converges linearly with
+        // a rate close to one for large counts, while the quasi-Newton steps
+        // follow the curvature. Steps that leave the shape or do not lower
+        // the energy enough are halved, and if that fails the iteration takes
+        // a Lloyd step (which always lowers the energy) and forgets its history.
+        std::vector<std::vector<Point2>> stepHistory, gradientHistory;
+        std::vector<double> curvature;
+        std::vector<double> alpha(kHistory);
+        for (int iteration = 0; iteration < maxIterations; ++iteration)
+        {
+            double maxMove = 0.0;
+            for (int i = 0; i < count; ++i)
+            {
+                if (areas[i] > 0.0)
+                    maxMove = std::max({maxMove, std::fabs(centroids[i].x - generators[i].x),
+                                        std::fabs(centroids[i].y - generators[i].y)});
+            }
+            if (maxMove <= tolerance)
+                break;
+            layout.iterations = iteration + 1;
+
+            // Two-loop recursion for the quasi-Newton direction; without
+            // history the direction is the Lloyd step
+            bool accepted = false;
+            if (!stepHistory.empty())
+            {
+                direction = gradient;
+                for (int h = static_cast<int>(stepHistory.size()) - 1; h >= 0; --h)
+                {
+                    alpha[h] = curvature[h] * dot(stepHistory[h], direction);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        direction[i].x -= alpha[h] * gradientHistory[h][i].x;
+                        direction[i].y -= alpha[h] * gradientHistory[h][i].y;
+                    }
+                }
+                const auto &lastStep = stepHistory.back();
+                const auto &lastChange = gradientHistory.back();
+                double scale = dot(lastStep, lastChange) / dot(lastChange, lastChange);
+                for (auto &d : direction)
+                    d = Point2{scale * d.x, scale * d.y};
+                for (std::size_t h = 0; h < stepHistory.size(); ++h)
+                {
+                    double beta = curvature[h] * dot(gradientHistory[h], direction);
+                    for (int i = 0; i < count; ++i)
+                    {
+                        direction[i].x += (alpha[h] - beta) * stepHistory[h][i].x;
+                        direction[i].y += (alpha[h] - beta) * stepHistory[h][i].y;
+                    }
+                }
+                for (auto &d : direction)
+                    d = Point2{-d.x, -d.y};
+
+                double slope = dot(gradient, direction);
+                double step = 1.0;
+                for (int backtrack = 0; slope < 0.0 && backtrack <= kMaxBacktracks && !accepted;
+                     ++backtrack, step *= 0.5)
+                {
+                    bool inside = true;
+                    for (int i = 0; i < count && inside; ++i)
+                    {
+                        trial[i] = Point2{generators[i].x + step * direction[i].x, generators[i].y + step * direction[i].y};
+                        inside = isInside(shape, trial[i]);
+                    }
+                    if (!inside)
+                        continue;
+                    double trialEnergy = cells.evaluate(trial, trialCentroids, trialAreas);
+                    if (trialEnergy <= energy + kArmijo * step * slope)
+                    {
+                        accepted = true;
+                        energy = trialEnergy;
+                    }
+                }
+            }
+            if (!accepted)
+            {
+                stepHistory.clear();
+                gradientHistory.clear();
+                curvature.clear();
+                for (int i = 0; i < count; ++i)
+                    trial[i] = (areas[i] > 0.0) ? centroids[i] : generators[i];
+                energy = cells.evaluate(trial, trialCentroids, trialAreas);
+            }
+
+            // Remember the step and gradient change if the curvature is positive
+            computeGradient(trial, trialCentroids, trialAreas, trialGradient);
+            std::vector<Point2> stepTaken(count), gradientChange(count);
+            for (int i = 0; i < count; ++i)
+            {
+                stepTaken[i] = Point2{trial[i].x - generators[i].x, trial[i].y - generators[i].y};
+                gradientChange[i] = Point2{trialGradient[i].x - gradient[i].x, trialGradient[i].y - gradient[i].y};
+            }
+            double sy = dot(stepTaken, gradientChange);
+            if (sy > 1e-12 * std::sqrt(dot(stepTaken, stepTaken) * dot(gradientChange, gradientChange)))
+            {
+                if (static_cast<int>(stepHistory.size()) == kHistory)
+                {
+                    stepHistory.erase(stepHistory.begin());
+                    gradientHistory.erase(gradientHistory.begin());
+                    curvature.erase(curvature.begin());
+                }
+                stepHistory.push_back(std::move(stepTaken));
+                gradientHistory.push_back(std::move(gradientChange));
+                curvature.push_back(1.0 / sy);
+            }
+
+            generators.swap(trial);
+            centroids.swap(trialCentroids);
+            areas.swap(trialAreas);
+            gradient.swap(trialGradient);
+        }
+
+        // Report the centroids of the last cells, which tile the shape
+        layout.xi.resize(count);
+        layout.eta.resize(count);
+        layout.cellArea.assign(areas.begin(), areas.end());
+        for (int k = 0; k < count; ++k)
+        {
+            layout.xi[k] = centroids[k].x;
+            layout.eta[k] = centroids[k].y;
+        }
+        return layout;
+    }
+
+    const CentroidalLayout &getCentroidalLayout(ReferenceShape shape, int count)
+    {
+        // Entries are never evicted, so references to them stay valid. Each
+        // layout is computed once by the first thread asking for it; others
+        // wait for it instead of computing it too.
+        struct Entry
+        {
+            std::once_flag once;
+            CentroidalLayout layout;
+        };
+        static std::mutex mutex;
+        static std::map<std::pair<ReferenceShape, int>, std::unique_ptr<Entry>> cache;
+
+        struct LastLayout
+        {
+            int count;
+            const CentroidalLayout *layout;
+        };
+        thread_local LastLayout last[2] = {};
+
+        LastLayout &slot = last[shape == ReferenceShape::QUAD ? 1 : 0];
+        if (slot.layout && slot.count == count)
+            return *slot.layout;
+
+        Entry *entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::unique_ptr<Entry> &cached = cache[std::make_pair(shape, count)];
+            if (!cached)
+                cached = std::make_unique<Entry>();
+            entry = cached.get();
+        }
+        std::call_once(entry->once, [&]
+                       { entry->layout = computeCentroidalLayout(shape, count); });
+
+        slot = LastLayout{count, &entry->layout};
+        return entry->layout;
+    }
+
+} // namespace czm_face
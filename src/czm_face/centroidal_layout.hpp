@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include "quadrature.hpp"
+
+namespace czm_face
+{
+
+    // Centroidal Voronoi layout of points on a reference shape (see
+    // ReferenceShape). The Voronoi cells of the last iteration, clipped to
+    // the shape, tile it; point k is the centroid of cell k and cellArea[k]
+    // its reference area.
+    struct CentroidalLayout
+    {
+        std::vector<double> xi;       // Point reference coordinates
+        std::vector<double> eta;
+        std::vector<double> cellArea; // Reference area of each cell
+        int iterations = 0;           // Iterations performed
+
+        // Get number of points
+        std::size_t size() const { return xi.size(); }
+    };
+
+    // Compute a layout of count points by minimising the Voronoi energy with
+    // L-BFGS (falling back to Lloyd steps), starting from a Halton sequence
+    // and stopping when no generator is further than tolerance from its
+    // centroid or after maxIterations. Cells are built by clipping
+    // the shape against the bisectors of generators found in a bucket grid.
+    CentroidalLayout computeCentroidalLayout(ReferenceShape shape, int count,
+                                             int maxIterations = 1000, double tolerance = 1e-9);
+
+    // Get the converged layout for (shape, count) from a process-wide,
+    // thread-safe cache that never evicts; the layout is computed once, on
+    // first use, and each thread remembers the last layout per shape.
+    const CentroidalLayout &getCentroidalLayout(ReferenceShape shape, int count);
+
+} // namespace czm_face
@@ -1,7 +1,10 @@
 #include "czm_face.hpp"
+#include "centroidal_layout.hpp"
+#include "polygon2d.hpp"
+#include "reference_pattern.hpp"
 #include <stdexcept>
 #include <cmath>
-#include <random>
+#include <type_traits>
 
 namespace czm_face
 {
@@ -12,18 +15,26 @@ namespace czm_face
     }
 
     bool CzmFace::createFace(const std::vector<Vec3D> &vertices)
+    {
+        return createFace(vertices.data(), vertices.size());
+    }
+
+    bool CzmFace::createFace(const Vec3D *vertices, std::size_t count)
     {
         // Check if we have 3 or 4 vertices
-        if (vertices.size() != 3 && vertices.size() != 4)
+        if (count != 3 && count != 4)
         {
             return false;
         }
 
         // Store vertices
-        vertices_ = vertices;
+        std::copy(vertices, vertices + count, vertices_.begin());
+        numVertices_ = static_cast<std::uint8_t>(count);
+        for (std::size_t i = 0; i < count; ++i)
+            inputOrder_[i] = static_cast<std::uint8_t>(i);
 
         // For quadrilateral, sort vertices
-        if (vertices_.size() == 4)
+        if (numVertices_ == 4)
         {
             sortQuadVertices();
         }
@@ -31,51 +42,127 @@ namespace czm_face
         // Create edges
         createEdges();
 
-        // Calculate face normal
-        calculateNormal();
+        // Calculate derived geometry
+        dirty_ = kAllDirty;
+        refreshGeometry();
 
         return true;
     }
 
-    void CzmFace::createEdges()
+    bool CzmFace::updateVertices(const std::vector<Vec3D> &vertices)
     {
-        edges_.clear();
-        for (size_t i = 0; i < vertices_.size(); ++i)
+        return updateVertices(vertices.data(), vertices.size());
+    }
+
+    bool CzmFace::updateVertices(const Vec3D *vertices, std::size_t count)
+    {
+        // Topology is kept, so the vertex count must match
+        if (numVertices_ < 3 || count != numVertices_)
         {
-            size_t next = (i + 1) % vertices_.size();
-            edges_.emplace_back(vertices_[i], vertices_[next]);
+            return false;
         }
+
+        for (std::size_t i = 0; i < count; ++i)
+            vertices_[i] = vertices[inputOrder_[i]];
+        dirty_ = kAllDirty;
+        return true;
     }
 
-    void CzmFace::sortQuadVertices()
+    void CzmFace::refreshGeometry()
     {
-        if (vertices_.size() != 4)
-            return;
+        getNormal();
+        calculateArea();
+        calculateCenter();
+        calculatePerimeter();
+    }
+
+    Vec3D CzmFace::getNormal() const
+    {
+        if (dirty_ & kNormalDirty)
+        {
+            calculateNormal();
+            dirty_ &= ~kNormalDirty;
+        }
+        return normal_;
+    }
+
+    void CzmFace::createEdges()
+    {
+        for (int i = 0; i < numVertices_; ++i)
+        {
+            edges_[i].start = static_cast<std::uint8_t>(i);
+            edges_[i].end = static_cast<std::uint8_t>((i + 1) % numVertices_);
+        }
+    }
 
-        // Calculate face center
-        Vec3D center = calculateCenter();
+    void orderQuadVertices(Vec3D *vertices, std::uint8_t *order)
+    {
+        // Calculate quadrilateral center
+        Vec3D center = (vertices[0] + vertices[1] + vertices[2] + vertices[3]) / 4.0;
+
+        // Plane normal from the vertex triple spanning the largest triangle,
+        // which is valid whatever the current vertex order is
+        Vec3D d1 = vertices[1] - vertices[0];
+        Vec3D d2 = vertices[2] - vertices[0];
+        Vec3D d3 = vertices[3] - vertices[0];
+        Vec3D normal = d1.cross(d2);
+        for (const Vec3D &candidate : {d1.cross(d3), d2.cross(d3)})
+        {
+            if (candidate.squaredLength() > normal.squaredLength())
+                normal = candidate;
+        }
 
-        // Sort vertices based on their angle with negative x-axis
-        std::sort(vertices_.begin(), vertices_.end(),
-                  [&center](const Vec3D &a, const Vec3D &b)
+        // Sort in the coordinate plane most parallel to the face so that
+        // faces not lying in a z=const plane are ordered correctly too
+        int axis = 2;
+        if (std::fabs(normal.comp[0]) > std::fabs(normal.comp[axis]))
+            axis = 0;
+        if (std::fabs(normal.comp[1]) > std::fabs(normal.comp[axis]))
+            axis = 1;
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+
+        // Sort vertex indices by the angle of their vertex with the negative u-axis
+        std::uint8_t sorted[4] = {0, 1, 2, 3};
+        std::sort(sorted, sorted + 4,
+                  [vertices, &center, u, v](std::uint8_t ia, std::uint8_t ib)
                   {
+                      const Vec3D &a = vertices[ia];
+                      const Vec3D &b = vertices[ib];
+
                       // Calculate vectors from center to points
-                      double ax = a.comp[0] - center.comp[0];
-                      double ay = a.comp[1] - center.comp[1];
-                      double bx = b.comp[0] - center.comp[0];
-                      double by = b.comp[1] - center.comp[1];
+                      double au = a.comp[u] - center.comp[u];
+                      double av = a.comp[v] - center.comp[v];
+                      double bu = b.comp[u] - center.comp[u];
+                      double bv = b.comp[v] - center.comp[v];
 
-                      // Calculate angles with negative x-axis
-                      double angleA = std::atan2(ay, -ax);
-                      double angleB = std::atan2(by, -bx);
+                      // Calculate angles with negative u-axis
+                      double angleA = std::atan2(av, -au);
+                      double angleB = std::atan2(bv, -bu);
 
                       return angleA < angleB;
                   });
+
+        Vec3D input[4] = {vertices[0], vertices[1], vertices[2], vertices[3]};
+        for (int i = 0; i < 4; ++i)
+        {
+            vertices[i] = input[sorted[i]];
+            if (order)
+                order[i] = sorted[i];
+        }
     }
 
-    void CzmFace::calculateNormal()
+    void CzmFace::sortQuadVertices()
     {
-        if (vertices_.size() < 3)
+        if (numVertices_ != 4)
+            return;
+
+        orderQuadVertices(vertices_.data(), inputOrder_.data());
+    }
+
+    void CzmFace::calculateNormal() const
+    {
+        if (numVertices_ < 3)
         {
             normal_ = Vec3D(0, 0, 0);
             return;
@@ -100,12 +187,22 @@ namespace czm_face
 
     double CzmFace::calculateArea() const
     {
-        if (vertices_.size() < 3)
+        if (dirty_ & kAreaDirty)
+        {
+            area_ = computeArea();
+            dirty_ &= ~kAreaDirty;
+        }
+        return area_;
+    }
+
+    double CzmFace::computeArea() const
+    {
+        if (numVertices_ < 3)
         {
             return 0.0;
         }
 
-        if (vertices_.size() == 3)
+        if (numVertices_ == 3)
         {
             // Triangle area = 1/2 * |(v1-v0) × (v2-v0)|
             Vec3D v1 = vertices_[1] - vertices_[0];
@@ -141,23 +238,43 @@ namespace czm_face
     }
 
     double CzmFace::calculatePerimeter() const
+    {
+        if (dirty_ & kPerimeterDirty)
+        {
+            perimeter_ = computePerimeter();
+            dirty_ &= ~kPerimeterDirty;
+        }
+        return perimeter_;
+    }
+
+    double CzmFace::computePerimeter() const
     {
         double perimeter = 0.0;
-        for (const auto &edge : edges_)
+        for (int i = 0; i < getNumEdges(); ++i)
         {
-            perimeter += edge.length();
+            perimeter += getEdge(i).length();
         }
         return perimeter;
     }
 
     Vec3D CzmFace::calculateCenter() const
     {
-        if (vertices_.size() < 3)
+        if (dirty_ & kCenterDirty)
+        {
+            center_ = computeCenter();
+            dirty_ &= ~kCenterDirty;
+        }
+        return center_;
+    }
+
+    Vec3D CzmFace::computeCenter() const
+    {
+        if (numVertices_ < 3)
         {
             return Vec3D(0, 0, 0);
         }
 
-        if (vertices_.size() == 3)
+        if (numVertices_ == 3)
         {
             // Triangle center = (v0 + v1 + v2) / 3
             return (vertices_[0] + vertices_[1] + vertices_[2]) / 3.0;
@@ -169,59 +286,350 @@ namespace czm_face
         }
     }
 
+    BoundingBox CzmFace::calculateBoundingBox() const
+    {
+        BoundingBox box;
+        for (const auto &v : getVertices())
+        {
+            box.expand(v);
+        }
+        return box;
+    }
+
+    Vec3D CzmFace::mapReferencePoint(double xi, double eta) const
+    {
+        if (numVertices_ == 3)
+        {
+            return vertices_[0] + xi * (vertices_[1] - vertices_[0]) + eta * (vertices_[2] - vertices_[0]);
+        }
+
+        return (1.0 - xi) * (1.0 - eta) * vertices_[0] + xi * (1.0 - eta) * vertices_[1] +
+               xi * eta * vertices_[2] + (1.0 - xi) * eta * vertices_[3];
+    }
+
+    double CzmFace::mapJacobian(double xi, double eta) const
+    {
+        if (numVertices_ == 3)
+        {
+            return (vertices_[1] - vertices_[0]).cross(vertices_[2] - vertices_[0]).length();
+        }
+
+        Vec3D dXi = (1.0 - eta) * (vertices_[1] - vertices_[0]) + eta * (vertices_[2] - vertices_[3]);
+        Vec3D dEta = (1.0 - xi) * (vertices_[3] - vertices_[0]) + xi * (vertices_[2] - vertices_[1]);
+        return dXi.cross(dEta).length();
+    }
+
+    namespace
+    {
+        // Quadrature family of a point generation method
+        QuadratureFamily quadratureFamily(PointGenerationMethod method)
+        {
+            return (method == PointGenerationMethod::LOBATTO) ? QuadratureFamily::LOBATTO : QuadratureFamily::GAUSS;
+        }
+
+        // Axis-aligned lattice over the XY bounding box of a face, used by
+        // the grid and equal-area generators
+        struct GridLattice
+        {
+            double minX, minY, minZ;
+            double spacingX, spacingY;
+            int numPointsX, numPointsY;
+        };
+
+        GridLattice makeAreaLattice(const BoundingBox &box, double areaPerPoint)
+        {
+            GridLattice lattice;
+
+            double minX = box.min.comp[0], maxX = box.max.comp[0];
+            double minY = box.min.comp[1], maxY = box.max.comp[1];
+
+            // Calculate grid spacing based on area per point
+            double spacing = std::sqrt(areaPerPoint);
+
+            // Calculate number of points in each direction
+            lattice.numPointsX = static_cast<int>(std::ceil((maxX - minX) / spacing));
+            lattice.numPointsY = static_cast<int>(std::ceil((maxY - minY) / spacing));
+
+            // Adjust spacing to ensure exact number of points
+            lattice.spacingX = (maxX - minX) / (lattice.numPointsX - 1);
+            lattice.spacingY = (maxY - minY) / (lattice.numPointsY - 1);
+
+            lattice.minX = minX;
+            lattice.minY = minY;
+            lattice.minZ = box.min.comp[2];
+            return lattice;
+        }
+
+        // Radical inverse of index in a prime base (Halton sequence component)
+        double radicalInverse(int index, int base)
+        {
+            double inverse = 0.0;
+            double scale = 1.0 / base;
+            for (; index > 0; index /= base, scale /= base)
+            {
+                inverse += (index % base) * scale;
+            }
+            return inverse;
+        }
+
+        // Root in [0, 1] of half * x^2 + linear * x = target for a quadratic
+        // increasing on [0, 1] (linear > 0), in a form stable for half -> 0
+        double solveIncreasingQuadratic(double half, double linear, double target)
+        {
+            double discriminant = std::max(linear * linear + 4.0 * half * target, 0.0);
+            double denominator = linear + std::sqrt(discriminant);
+            return (denominator > 0.0) ? std::min(std::max(2.0 * target / denominator, 0.0), 1.0) : 0.0;
+        }
+
+        // Sink writing into a caller-provided buffer; keeps counting past its end
+        struct SpanWriter
+        {
+            Span<CZM_Point> output;
+            std::size_t count = 0;
+
+            void operator()(const CZM_Point &point)
+            {
+                if (count < output.size())
+                {
+                    output[count] = point;
+                }
+                ++count;
+            }
+        };
+
+        // Sink writing points and weights into caller-provided buffers
+        struct WeightedSpanWriter
+        {
+            Span<CZM_Point> output;
+            Span<double> weights;
+            std::size_t count = 0;
+
+            void operator()(const CZM_Point &point, double weight)
+            {
+                if (count < output.size())
+                    output[count] = point;
+                if (count < weights.size())
+                    weights[count] = weight;
+                ++count;
+            }
+        };
+
+        // Pass a point to a sink, with its weight if the sink takes one.
+        // The weight is computed lazily, so unweighted sinks never pay for it.
+        template <typename Sink, typename Point, typename Weight>
+        void emitPoint(Sink &sink, const Point &point, Weight &&weight)
+        {
+            if constexpr (std::is_invocable_v<Sink &, const Point &, double>)
+                sink(point, weight());
+            else
+                sink(point);
+        }
+    }
+
     std::vector<CZM_Point> CzmFace::generatePointGrid(int pointsPerEdge, PointGenerationMethod method) const
     {
-        std::vector<CZM_Point> points;
+        std::vector<CZM_Point> points(countPoints(pointsPerEdge, method));
+        generatePointGrid(pointsPerEdge, method, Span<CZM_Point>(points));
+        return points;
+    }
+
+    std::size_t CzmFace::generatePointGrid(int pointsPerEdge, PointGenerationMethod method,
+                                           Span<CZM_Point> output) const
+    {
+        SpanWriter writer{output};
+        visitPointGrid(pointsPerEdge, method, writer);
+        return writer.count;
+    }
+
+    std::vector<CZM_Point> CzmFace::generatePointGrid(int pointsPerEdge, PointGenerationMethod method,
+                                                      std::vector<double> &weights) const
+    {
+        std::size_t count = countPoints(pointsPerEdge, method);
+        std::vector<CZM_Point> points(count);
+        weights.assign(count, 0.0);
+        generatePointGrid(pointsPerEdge, method, Span<CZM_Point>(points), Span<double>(weights));
+        return points;
+    }
+
+    std::size_t CzmFace::generatePointGrid(int pointsPerEdge, PointGenerationMethod method,
+                                           Span<CZM_Point> output, Span<double> weights) const
+    {
+        WeightedSpanWriter writer{output, weights};
+        visitPointGrid(pointsPerEdge, method, writer);
+        return writer.count;
+    }
+
+    std::size_t CzmFace::countPoints(int pointsPerEdge, PointGenerationMethod method) const
+    {
+        // Edge points have a closed-form count; grid points need the inside test
+        std::size_t edgePoints = static_cast<std::size_t>(getNumEdges()) * std::max(pointsPerEdge, 0);
+        std::size_t count = 0;
+        auto counter = [&count](const CZM_Point &)
+        { ++count; };
 
         switch (method)
         {
         case PointGenerationMethod::EDGE_ONLY:
-            return generateEdgePoints(pointsPerEdge);
+            return edgePoints;
 
         case PointGenerationMethod::INTERIOR_ONLY:
-            return generateInteriorGridPoints(pointsPerEdge);
+            visitInteriorGridPoints(pointsPerEdge, counter);
+            return count;
 
         case PointGenerationMethod::UNIFORM_GRID:
-            return generateUniformGridPoints(pointsPerEdge);
+            visitUniformGridPoints(pointsPerEdge, counter);
+            return count;
+
+        case PointGenerationMethod::PARAMETRIC_GRID:
+        {
+            // n^2 lattice points on a quad, n(n+1)/2 on a triangle
+            std::size_t n = (pointsPerEdge >= 2 && numVertices_ >= 3) ? static_cast<std::size_t>(pointsPerEdge) : 0;
+            return (numVertices_ == 4) ? n * n : n * (n + 1) / 2;
+        }
+
+        case PointGenerationMethod::GAUSS:
+        case PointGenerationMethod::LOBATTO:
+        {
+            ReferenceShape shape = getReferenceShape();
+            const ReferenceQuadrature *rule = getReferenceQuadrature(shape, quadratureFamily(method), pointsPerEdge);
+            return (rule && numVertices_ >= 3) ? static_cast<std::size_t>(rule->numPoints) : 0;
+        }
 
         case PointGenerationMethod::EDGE_AND_INTERIOR:
         default:
-            auto edgePoints = generateEdgePoints(pointsPerEdge);
-            auto interiorPoints = generateInteriorGridPoints(pointsPerEdge);
-            points.insert(points.end(), edgePoints.begin(), edgePoints.end());
-            points.insert(points.end(), interiorPoints.begin(), interiorPoints.end());
-            return points;
+            visitInteriorGridPoints(pointsPerEdge, counter);
+            return edgePoints + count;
         }
     }
 
-    std::vector<CZM_Point> CzmFace::generateEdgePoints(int pointsPerEdge) const
+    template <typename Sink>
+    void CzmFace::visitPointGrid(int pointsPerEdge, PointGenerationMethod method, Sink &&sink) const
     {
-        std::vector<CZM_Point> points;
-        for (const auto &edge : edges_)
+        switch (method)
         {
-            Vec3D start = edge.getStart();
-            Vec3D end = edge.getEnd();
-
-            for (int i = 0; i < pointsPerEdge; ++i)
+        case PointGenerationMethod::EDGE_ONLY:
+        case PointGenerationMethod::PARAMETRIC_GRID:
+        case PointGenerationMethod::GAUSS:
+        case PointGenerationMethod::LOBATTO:
+            // Same layout on every face of a shape: map the cached pattern,
+            // or generate its points in closed form for densities too large
+            // to cache
+            if (numVertices_ >= 3)
             {
-                double t = static_cast<double>(i) / (pointsPerEdge - 1);
-                Vec3D position;
-                position.comp[0] = start.comp[0] + (end.comp[0] - start.comp[0]) * t;
-                position.comp[1] = start.comp[1] + (end.comp[1] - start.comp[1]) * t;
-                position.comp[2] = start.comp[2] + (end.comp[2] - start.comp[2]) * t;
-
-                CZM_Point point(position, PointType::EDGE_POINT);
-                point.setEdge(&edge);
-                points.push_back(std::move(point));
+                const ReferencePattern *pattern = getDefaultReferencePattern(getReferenceShape(), method, pointsPerEdge);
+                if (pattern)
+                {
+                    visitReferencePattern(*pattern, 0, pattern->size(), sink);
+                    break;
+                }
+                bool edgeParameters = (method == PointGenerationMethod::EDGE_ONLY);
+                visitReferencePatternPoints(getReferenceShape(), method, pointsPerEdge,
+                                            [&](double xi, double eta, int edge, double measure, double measureXi,
+                                                double measureEta)
+                                            { visitReferencePoint(edgeParameters, xi, eta, edge, measure, measureXi,
+                                                                  measureEta, sink); });
             }
+            break;
+
+        case PointGenerationMethod::INTERIOR_ONLY:
+            visitInteriorGridPoints(pointsPerEdge, sink);
+            break;
+
+        case PointGenerationMethod::UNIFORM_GRID:
+            visitUniformGridPoints(pointsPerEdge, sink);
+            break;
+
+        case PointGenerationMethod::EDGE_AND_INTERIOR:
+        default:
+            visitPointGrid(pointsPerEdge, PointGenerationMethod::EDGE_ONLY, sink);
+            visitInteriorGridPoints(pointsPerEdge, sink);
+            break;
         }
-        return points;
     }
 
-    std::vector<CZM_Point> CzmFace::generateInteriorGridPoints(int pointsPerEdge) const
+    template <typename Sink>
+    void CzmFace::visitReferencePattern(const ReferencePattern &pattern, std::size_t begin, std::size_t end,
+                                        Sink &&sink) const
+    {
+        for (std::size_t k = begin; k < end; ++k)
+        {
+            visitReferencePoint(pattern.edgeParameters, pattern.xi[k], pattern.eta[k], pattern.edge[k],
+                                pattern.measure[k], pattern.measureXi[k], pattern.measureEta[k], sink);
+        }
+    }
+
+    template <typename Sink>
+    void CzmFace::visitReferencePoint(bool edgeParameters, double xi, double eta, int edge, double measure,
+                                      double measureXi, double measureEta, Sink &&sink) const
+    {
+        if (edgeParameters)
+        {
+            const Vec3D &start = vertices_[edges_[edge].start];
+            const Vec3D &end = vertices_[edges_[edge].end];
+            Vec3D position;
+            position.comp[0] = start.comp[0] + (end.comp[0] - start.comp[0]) * xi;
+            position.comp[1] = start.comp[1] + (end.comp[1] - start.comp[1]) * xi;
+            position.comp[2] = start.comp[2] + (end.comp[2] - start.comp[2]) * xi;
+
+            CZM_Point point(position, PointType::EDGE_POINT);
+            point.setEdgeIndex(edge);
+            emitPoint(sink, point, [&]
+                      { return measure * (end - start).length(); });
+            return;
+        }
+
+        CZM_Point point(mapReferencePoint(xi, eta), edge < 0 ? PointType::INTERIOR_POINT : PointType::EDGE_POINT);
+        point.setEdgeIndex(edge);
+        emitPoint(sink, point, [&]
+                  { return measure * mapJacobian(measureXi, measureEta); });
+    }
+
+    std::size_t CzmFace::mapReferencePattern(const ReferencePattern &pattern, Span<CZM_Point> output) const
+    {
+        if (numVertices_ < 3 || pattern.shape != getReferenceShape())
+            return 0;
+
+        SpanWriter writer{output};
+        visitReferencePattern(pattern, 0, pattern.size(), writer);
+        return writer.count;
+    }
+
+    std::size_t CzmFace::mapReferencePattern(const ReferencePattern &pattern, Span<CZM_Point> output,
+                                             Span<double> weights) const
     {
-        std::vector<CZM_Point> points;
+        if (numVertices_ < 3 || pattern.shape != getReferenceShape())
+            return 0;
+
+        WeightedSpanWriter writer{output, weights};
+        visitReferencePattern(pattern, 0, pattern.size(), writer);
+        return writer.count;
+    }
 
+    std::size_t CzmFace::mapReferencePattern(const ReferencePattern &pattern, std::size_t first,
+                                             Span<CZM_Point> output) const
+    {
+        if (numVertices_ < 3 || pattern.shape != getReferenceShape() || first >= pattern.size())
+            return 0;
+
+        SpanWriter writer{output};
+        visitReferencePattern(pattern, first, first + std::min(output.size(), pattern.size() - first), writer);
+        return writer.count;
+    }
+
+    std::size_t CzmFace::mapReferencePattern(const ReferencePattern &pattern, std::size_t first,
+                                             Span<CZM_Point> output, Span<double> weights) const
+    {
+        if (numVertices_ < 3 || pattern.shape != getReferenceShape() || first >= pattern.size())
+            return 0;
+
+        WeightedSpanWriter writer{output, weights};
+        visitReferencePattern(pattern, first, first + std::min(output.size(), pattern.size() - first), writer);
+        return writer.count;
+    }
+
+    template <typename Sink>
+    void CzmFace::visitInteriorGridPoints(int pointsPerEdge, Sink &&sink) const
+    {
         // Calculate total area
         double totalArea = calculateArea();
 
@@ -232,70 +640,34 @@ namespace czm_face
         // Calculate area per point
         double areaPerPoint = totalArea / numInteriorPoints;
 
-        // Calculate grid spacing based on area per point
-        double spacing = std::sqrt(areaPerPoint);
-
-        // Calculate bounding box
-        double minX = vertices_[0].comp[0], maxX = vertices_[0].comp[0];
-        double minY = vertices_[0].comp[1], maxY = vertices_[0].comp[1];
-        double minZ = vertices_[0].comp[2], maxZ = vertices_[0].comp[2];
-
-        for (const auto &v : vertices_)
-        {
-            minX = std::min(minX, v.comp[0]);
-            maxX = std::max(maxX, v.comp[0]);
-            minY = std::min(minY, v.comp[1]);
-            maxY = std::max(maxY, v.comp[1]);
-            minZ = std::min(minZ, v.comp[2]);
-            maxZ = std::max(maxZ, v.comp[2]);
-        }
-
-        // Calculate number of points in each direction
-        int numPointsX = static_cast<int>(std::ceil((maxX - minX) / spacing));
-        int numPointsY = static_cast<int>(std::ceil((maxY - minY) / spacing));
-
-        // Adjust spacing to ensure exact number of points
-        double spacingX = (maxX - minX) / (numPointsX - 1);
-        double spacingY = (maxY - minY) / (numPointsY - 1);
+        GridLattice lattice = makeAreaLattice(calculateBoundingBox(), areaPerPoint);
 
         // Generate interior grid points
-        for (int i = 1; i < numPointsX - 1; ++i)
+        for (int i = 1; i < lattice.numPointsX - 1; ++i)
         {
-            for (int j = 1; j < numPointsY - 1; ++j)
+            for (int j = 1; j < lattice.numPointsY - 1; ++j)
             {
-                Vec3D point(minX + i * spacingX, minY + j * spacingY, minZ);
+                Vec3D point(lattice.minX + i * lattice.spacingX, lattice.minY + j * lattice.spacingY, lattice.minZ);
                 if (isPointInside(point))
                 {
                     CZM_Point interiorPoint(point, PointType::INTERIOR_POINT);
-                    points.push_back(std::move(interiorPoint));
+                    emitPoint(sink, interiorPoint, [&]
+                              { return calculateClippedArea(point, lattice.spacingX, lattice.spacingY); });
                 }
             }
         }
-
-        return points;
     }
 
-    std::vector<CZM_Point> CzmFace::generateUniformGridPoints(int pointsPerEdge) const
+    template <typename Sink>
+    void CzmFace::visitUniformGridPoints(int pointsPerEdge, Sink &&sink) const
     {
-        std::vector<CZM_Point> points;
-
-        // Calculate bounding box
-        double minX = vertices_[0].comp[0], maxX = vertices_[0].comp[0];
-        double minY = vertices_[0].comp[1], maxY = vertices_[0].comp[1];
-        double minZ = vertices_[0].comp[2], maxZ = vertices_[0].comp[2];
-
-        for (const auto &v : vertices_)
-        {
-            minX = std::min(minX, v.comp[0]);
-            maxX = std::max(maxX, v.comp[0]);
-            minY = std::min(minY, v.comp[1]);
-            maxY = std::max(maxY, v.comp[1]);
-            minZ = std::min(minZ, v.comp[2]);
-            maxZ = std::max(maxZ, v.comp[2]);
-        }
+        BoundingBox box = calculateBoundingBox();
+        double minX = box.min.comp[0], maxX = box.max.comp[0];
+        double minY = box.min.comp[1], maxY = box.max.comp[1];
+        double minZ = box.min.comp[2];
 
         // Calculate grid spacing based on edge length
-        double edgeLength = edges_[0].length();
+        double edgeLength = getEdge(0).length();
         double spacing = edgeLength / (pointsPerEdge - 1);
 
         // Generate uniform grid points
@@ -307,101 +679,286 @@ namespace czm_face
                 if (isPointInside(point))
                 {
                     CZM_Point gridPoint(point, PointType::INTERIOR_POINT);
-                    points.push_back(std::move(gridPoint));
+                    emitPoint(sink, gridPoint, [&]
+                              { return calculateClippedArea(point, spacing, spacing); });
                 }
             }
         }
-
-        return points;
     }
 
-    std::vector<CZM_Point> CzmFace::generateEqualAreaPoints(int numPoints) const
+    template <typename Sink>
+    void CzmFace::visitEqualAreaCandidates(int numPoints, Sink &&sink) const
     {
-        std::vector<CZM_Point> points;
-        if (vertices_.size() < 3 || numPoints <= 0)
-            return points;
-
         // Calculate total area
         double totalArea = calculateArea();
         double areaPerPoint = totalArea / numPoints;
 
-        // Calculate bounding box
-        double minX = vertices_[0].comp[0], maxX = vertices_[0].comp[0];
-        double minY = vertices_[0].comp[1], maxY = vertices_[0].comp[1];
-        double minZ = vertices_[0].comp[2], maxZ = vertices_[0].comp[2];
+        GridLattice lattice = makeAreaLattice(calculateBoundingBox(), areaPerPoint);
 
-        for (const auto &v : vertices_)
+        // Generate initial grid points
+        for (int i = 0; i < lattice.numPointsX; ++i)
         {
-            minX = std::min(minX, v.comp[0]);
-            maxX = std::max(maxX, v.comp[0]);
-            minY = std::min(minY, v.comp[1]);
-            maxY = std::max(maxY, v.comp[1]);
-            minZ = std::min(minZ, v.comp[2]);
-            maxZ = std::max(maxZ, v.comp[2]);
+            for (int j = 0; j < lattice.numPointsY; ++j)
+            {
+                Vec3D point(lattice.minX + i * lattice.spacingX, lattice.minY + j * lattice.spacingY, lattice.minZ);
+                if (isPointInside(point))
+                {
+                    sink(point);
+                }
+            }
         }
+    }
+
+    template <typename Sink>
+    void CzmFace::visitStratifiedPoints(int numPoints, const EqualAreaOptions &options, Sink &&sink) const
+    {
+        // Per-face random shift of the Halton sequence (Cranley-Patterson rotation)
+        PhiloxStream random(options.seed, options.faceId);
+        double shiftS = random.nextDouble();
+        double shiftT = random.nextDouble();
+
+        // Quads are split into triangles (v0, v1, v2) and (v0, v2, v3); the
+        // first coordinate picks the triangle by area fraction
+        double split = 1.0;
+        if (numVertices_ == 4)
+        {
+            double area1 = 0.5 * (vertices_[1] - vertices_[0]).cross(vertices_[2] - vertices_[0]).length();
+            double area2 = 0.5 * (vertices_[2] - vertices_[0]).cross(vertices_[3] - vertices_[0]).length();
+            split = (area1 + area2 > 0.0) ? area1 / (area1 + area2) : 0.5;
+        }
+
+        for (int i = 1; i <= numPoints; ++i)
+        {
+            double s = radicalInverse(i, 2) + shiftS;
+            double t = radicalInverse(i, 3) + shiftT;
+            s -= std::floor(s);
+            t -= std::floor(t);
 
-        // Calculate initial grid spacing based on area per point
-        double spacing = std::sqrt(areaPerPoint);
+            int second = 2;
+            if (s >= split)
+            {
+                s = (s - split) / (1.0 - split);
+                second = 3;
+            }
+            else
+            {
+                s /= split;
+            }
 
-        // Calculate number of points in each direction
-        int numPointsX = static_cast<int>(std::ceil((maxX - minX) / spacing));
-        int numPointsY = static_cast<int>(std::ceil((maxY - minY) / spacing));
+            // Fold the unit square onto the triangle (area preserving)
+            if (s + t > 1.0)
+            {
+                s = 1.0 - s;
+                t = 1.0 - t;
+            }
 
-        // Adjust spacing to ensure exact number of points
-        double spacingX = (maxX - minX) / (numPointsX - 1);
-        double spacingY = (maxY - minY) / (numPointsY - 1);
+            const Vec3D &a = vertices_[0];
+            const Vec3D &b = vertices_[second - 1];
+            const Vec3D &c = vertices_[second];
+            sink(a + s * (b - a) + t * (c - a));
+        }
+    }
 
-        // Generate initial grid points
-        std::vector<Vec3D> initialPoints;
-        for (int i = 0; i < numPointsX; ++i)
+    template <typename Sink>
+    void CzmFace::visitCentroidalPoints(int numPoints, Sink &&sink) const
+    {
+        ReferenceShape shape = getReferenceShape();
+        const CentroidalLayout &layout = getCentroidalLayout(shape, numPoints);
+
+        // Reference cells map to cells of proportional area; the reference
+        // triangle has area 1/2 and the unit square area 1
+        double areaScale = calculateArea() / ((shape == ReferenceShape::TRIANGLE) ? 0.5 : 1.0);
+        if (shape == ReferenceShape::TRIANGLE)
         {
-            for (int j = 0; j < numPointsY; ++j)
+            for (std::size_t k = 0; k < layout.size(); ++k)
             {
-                Vec3D point(minX + i * spacingX, minY + j * spacingY, minZ);
-                if (isPointInside(point))
-                {
-                    initialPoints.push_back(point);
-                }
+                sink(mapReferencePoint(layout.xi[k], layout.eta[k]), layout.cellArea[k] * areaScale);
             }
+            return;
         }
 
-        // If we have too many points, randomly select the desired number
-        if (initialPoints.size() > numPoints)
+        // The bilinear map does not preserve area ratios, so quads first warp
+        // the unit square with the inverse distribution functions of the
+        // Jacobian (interpolated from the corners, exact for planar faces):
+        // xi from the marginal density, eta from the density conditional on xi
+        double j00 = mapJacobian(0.0, 0.0), j10 = mapJacobian(1.0, 0.0);
+        double j01 = mapJacobian(0.0, 1.0), j11 = mapJacobian(1.0, 1.0);
+        double marginal0 = 0.5 * (j00 + j01);
+        double marginal1 = 0.5 * ((j10 + j11) - (j00 + j01));
+        double total = marginal0 + 0.5 * marginal1;
+        for (std::size_t k = 0; k < layout.size(); ++k)
         {
-            std::random_device rd;
-            std::mt19937 gen(rd());
-            std::shuffle(initialPoints.begin(), initialPoints.end(), gen);
-            initialPoints.resize(numPoints);
+            double xi = solveIncreasingQuadratic(0.5 * marginal1, marginal0, layout.xi[k] * total);
+            double start = j00 + (j10 - j00) * xi;
+            double slope = (j01 - j00) + (j00 - j10 - j01 + j11) * xi;
+            double eta = solveIncreasingQuadratic(0.5 * slope, start, layout.eta[k] * (start + 0.5 * slope));
+            sink(mapReferencePoint(xi, eta), layout.cellArea[k] * areaScale);
         }
+    }
+
+    std::vector<CZM_Point> CzmFace::generateEqualAreaPoints(int numPoints) const
+    {
+        return generateEqualAreaPoints(numPoints, EqualAreaOptions());
+    }
+
+    std::vector<CZM_Point> CzmFace::generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options) const
+    {
+        std::vector<CZM_Point> points(countEqualAreaPoints(numPoints, options));
+        generateEqualAreaPoints(numPoints, options, Span<CZM_Point>(points));
+        return points;
+    }
 
-        // Convert to CZM_Points
-        for (const auto &point : initialPoints)
+    std::size_t CzmFace::countEqualAreaPoints(int numPoints) const
+    {
+        return countEqualAreaPoints(numPoints, EqualAreaOptions());
+    }
+
+    std::size_t CzmFace::countEqualAreaPoints(int numPoints, const EqualAreaOptions &options) const
+    {
+        if (numVertices_ < 3 || numPoints <= 0)
+            return 0;
+
+        if (options.selection != EqualAreaSelection::RANDOM)
+            return static_cast<std::size_t>(numPoints);
+
+        std::size_t candidates = 0;
+        visitEqualAreaCandidates(numPoints, [&candidates](const Vec3D &)
+                                 { ++candidates; });
+        return std::min(candidates, static_cast<std::size_t>(numPoints));
+    }
+
+    std::size_t CzmFace::generateEqualAreaPoints(int numPoints, Span<CZM_Point> output) const
+    {
+        return generateEqualAreaPoints(numPoints, EqualAreaOptions(), output);
+    }
+
+    template <typename Sink>
+    void CzmFace::visitEqualAreaPoints(int numPoints, const EqualAreaOptions &options, Sink &&sink) const
+    {
+        if (numVertices_ < 3 || numPoints <= 0)
+            return;
+
+        if (options.selection == EqualAreaSelection::STRATIFIED)
         {
-            points.emplace_back(point, PointType::INTERIOR_POINT);
+            // Low-discrepancy points have no cells; each gets an equal share
+            visitStratifiedPoints(numPoints, options, [&](const Vec3D &point)
+                                  { emitPoint(sink, CZM_Point(point, PointType::INTERIOR_POINT), [&]
+                                              { return calculateArea() / numPoints; }); });
+            return;
         }
+        if (options.selection == EqualAreaSelection::CENTROIDAL)
+        {
+            visitCentroidalPoints(numPoints, [&](const Vec3D &point, double area)
+                                  { emitPoint(sink, CZM_Point(point, PointType::INTERIOR_POINT), [area]
+                                              { return area; }); });
+            return;
+        }
+
+        std::size_t candidates = 0;
+        visitEqualAreaCandidates(numPoints, [&candidates](const Vec3D &)
+                                 { ++candidates; });
+
+        // If we have too many points, randomly select the desired number.
+        // Selection sampling streams the candidates once and picks each with
+        // probability (still needed) / (still available), which yields a
+        // uniformly random subset without storing the candidates.
+        std::size_t needed = std::min(candidates, static_cast<std::size_t>(numPoints));
+        PhiloxStream random(options.seed, options.faceId);
+
+        // A selected point stands for its lattice cell clipped to the face,
+        // scaled up by the fraction of candidates that were dropped
+        GridLattice lattice = makeAreaLattice(calculateBoundingBox(), calculateArea() / numPoints);
+        double scale = (needed > 0) ? static_cast<double>(candidates) / needed : 0.0;
+
+        std::size_t selected = 0;
+        std::size_t remaining = candidates;
+        visitEqualAreaCandidates(numPoints, [&](const Vec3D &point)
+                                 {
+                                     std::size_t stillNeeded = needed - selected;
+                                     if (stillNeeded > 0 &&
+                                         (stillNeeded == remaining ||
+                                          random.nextDouble() * remaining < stillNeeded))
+                                     {
+                                         emitPoint(sink, CZM_Point(point, PointType::INTERIOR_POINT), [&]
+                                                   { return scale * calculateClippedArea(point, lattice.spacingX, lattice.spacingY); });
+                                         ++selected;
+                                     }
+                                     --remaining; });
+    }
 
+    std::size_t CzmFace::generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options,
+                                                 Span<CZM_Point> output) const
+    {
+        SpanWriter writer{output};
+        visitEqualAreaPoints(numPoints, options, writer);
+        return writer.count;
+    }
+
+    std::vector<CZM_Point> CzmFace::generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options,
+                                                            std::vector<double> &areas) const
+    {
+        std::size_t count = countEqualAreaPoints(numPoints, options);
+        std::vector<CZM_Point> points(count);
+        areas.assign(count, 0.0);
+        generateEqualAreaPoints(numPoints, options, Span<CZM_Point>(points), Span<double>(areas));
         return points;
     }
 
+    std::size_t CzmFace::generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options,
+                                                 Span<CZM_Point> output, Span<double> areas) const
+    {
+        WeightedSpanWriter writer{output, areas};
+        visitEqualAreaPoints(numPoints, options, writer);
+        return writer.count;
+    }
+
+    double CzmFace::calculateClippedArea(const Vec3D &center, double sizeX, double sizeY) const
+    {
+        // Each clip turns n vertices into at most 3n/2, so a (possibly
+        // concave) quad clipped by four sides has at most 4, 6, 9, 13 and
+        // then 19 vertices; a convex one stays within 8
+        constexpr std::size_t kMaxVertices = 19;
+        std::array<Point2, kMaxVertices> polygon, clipped;
+        std::size_t count = numVertices_, clippedCount = 0;
+        for (int i = 0; i < numVertices_; ++i)
+            polygon[i] = Point2{vertices_[i].comp[0], vertices_[i].comp[1]};
+
+        auto clip = [&](const std::array<Point2, kMaxVertices> &input, std::size_t inputCount, double nx, double ny,
+                        double c, std::array<Point2, kMaxVertices> &output)
+        {
+            std::size_t outputCount = 0;
+            clipPolygon(input.data(), inputCount, nx, ny, c, [&](const Point2 &p)
+                        { output[outputCount++] = p; });
+            return outputCount;
+        };
+        double halfX = 0.5 * sizeX, halfY = 0.5 * sizeY;
+        clippedCount = clip(polygon, count, -1.0, 0.0, -(center.comp[0] - halfX), clipped);
+        count = clip(clipped, clippedCount, 1.0, 0.0, center.comp[0] + halfX, polygon);
+        clippedCount = clip(polygon, count, 0.0, -1.0, -(center.comp[1] - halfY), clipped);
+        count = clip(clipped, clippedCount, 0.0, 1.0, center.comp[1] + halfY, polygon);
+        return std::fabs(polygonArea(polygon.data(), count));
+    }
+
     bool CzmFace::isPointInside(const Vec3D &point) const
     {
-        if (vertices_.size() < 3)
+        if (numVertices_ < 3)
             return false;
 
         // Project point onto face plane
         Vec3D toPoint = point - vertices_[0];
-        double dot = toPoint.dot(normal_);
+        Vec3D normal = getNormal();
+        double dot = toPoint.dot(normal);
         Vec3D projectedPoint;
-        projectedPoint.comp[0] = point.comp[0] - normal_.comp[0] * dot;
-        projectedPoint.comp[1] = point.comp[1] - normal_.comp[1] * dot;
-        projectedPoint.comp[2] = point.comp[2] - normal_.comp[2] * dot;
+        projectedPoint.comp[0] = point.comp[0] - normal.comp[0] * dot;
+        projectedPoint.comp[1] = point.comp[1] - normal.comp[1] * dot;
+        projectedPoint.comp[2] = point.comp[2] - normal.comp[2] * dot;
 
         // Check if point is inside using ray casting
         int intersections = 0;
-        for (const auto &edge : edges_)
+        for (int e = 0; e < getNumEdges(); ++e)
         {
-            Vec3D edgeStart = edge.getStart();
-            Vec3D edgeEnd = edge.getEnd();
+            const Vec3D &edgeStart = vertices_[edges_[e].start];
+            const Vec3D &edgeEnd = vertices_[edges_[e].end];
 
             // Check if ray intersects edge
             if ((edgeStart.comp[1] > projectedPoint.comp[1]) != (edgeEnd.comp[1] > projectedPoint.comp[1]))
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <algorithm>
 #include "vec3d/vec3d.h"
+#include "bounding_box.hpp"
 #include "edge.hpp"
 #include "czm_point.hpp"
+#include "philox.hpp"
+#include "quadrature.hpp"
+#include "span.hpp"
 
 namespace czm_face
 {
@@ -15,18 +23,64 @@ namespace czm_face
         EDGE_ONLY,         // Only generate points on edges
         EDGE_AND_INTERIOR, // Generate points on edges and interior grid
         INTERIOR_ONLY,     // Only generate interior points
-        UNIFORM_GRID       // Generate uniform grid points only
+        UNIFORM_GRID,      // Generate uniform grid points only
+        PARAMETRIC_GRID,   // Map a reference lattice through the face's barycentric/bilinear map
+        GAUSS,             // Gauss-Legendre integration points (pointsPerEdge is the order)
+        LOBATTO            // Gauss-Lobatto integration points (pointsPerEdge is the order)
     };
 
+    enum class EqualAreaSelection
+    {
+        RANDOM,     // Random subset of a lattice over the face
+        STRATIFIED, // Low-discrepancy (Halton) points, exactly the requested count
+        CENTROIDAL  // Generators of a centroidal Voronoi tessellation
+    };
+
+    // Options of equal area point generation. Random numbers come from a
+    // Philox stream keyed by (seed, faceId), so results depend only on these
+    // values and not on call order or thread count.
+    struct EqualAreaOptions
+    {
+        std::uint64_t seed = 0;                                    // Global seed
+        std::uint64_t faceId = 0;                                  // Face identifier (random stream)
+        EqualAreaSelection selection = EqualAreaSelection::RANDOM; // Selection method
+    };
+
+    struct ReferencePattern;
+
+    // Order the four vertices of a quadrilateral cyclically around their
+    // center; if order is given, order[i] is set to the input index of the
+    // vertex now at i
+    void orderQuadVertices(Vec3D *vertices, std::uint8_t *order = nullptr);
+
+    // Vertex indices of a face edge
+    struct EdgeIndices
+    {
+        std::uint8_t start;
+        std::uint8_t end;
+    };
+
+    // Triangular or quadrilateral face. Vertices are stored inline and edges
+    // as vertex index pairs, so a face is a single trivially copyable object
+    // that can live in flat arrays and be copied with memcpy.
+    //
+    // Normal, area, center and perimeter are cached, so their accessors are
+    // O(1); the bounding box is computed on demand from the few vertices.
+    // createFace computes the cached values; updateVertices only marks them
+    // stale and the next query recomputes them, which writes to the face.
+    // Call refreshGeometry() (or query once) before reading an updated face
+    // from several threads.
     class CzmFace
     {
     public:
+        static constexpr int kMaxVertices = 4;
+
         CzmFace() = default;
         ~CzmFace() = default;
 
-        // Prevent copying
-        CzmFace(const CzmFace &) = delete;
-        CzmFace &operator=(const CzmFace &) = delete;
+        // Allow copying
+        CzmFace(const CzmFace &) = default;
+        CzmFace &operator=(const CzmFace &) = default;
 
         // Allow moving
         CzmFace(CzmFace &&) = default;
@@ -34,15 +88,31 @@ namespace czm_face
 
         // Create a face from 3 or 4 vertices
         bool createFace(const std::vector<Vec3D> &vertices);
+        bool createFace(const Vec3D *vertices, std::size_t count);
+
+        // Move the vertices of a created face, keeping its topology: vertices
+        // are given in the order passed to createFace and placed where
+        // createFace put them (quads are reordered), and edges are not
+        // rebuilt. Derived geometry is recomputed on demand. Returns false if
+        // the vertex count differs.
+        bool updateVertices(const std::vector<Vec3D> &vertices);
+        bool updateVertices(const Vec3D *vertices, std::size_t count);
+
+        // Recompute stale derived geometry now
+        void refreshGeometry();
 
         // Get face vertices
-        const std::vector<Vec3D> &getVertices() const { return vertices_; }
+        Span<const Vec3D> getVertices() const { return Span<const Vec3D>(vertices_.data(), numVertices_); }
+        int getNumVertices() const { return numVertices_; }
+        const Vec3D &getVertex(int i) const { return vertices_[i]; }
 
-        // Get face edges
-        const std::vector<Edge> &getEdges() const { return edges_; }
+        // Get face edges (edge i runs from vertex i to vertex i + 1)
+        int getNumEdges() const { return numVertices_; }
+        EdgeIndices getEdgeIndices(int i) const { return edges_[i]; }
+        Edge getEdge(int i) const { return Edge(vertices_[edges_[i].start], vertices_[edges_[i].end]); }
 
         // Get face normal
-        Vec3D getNormal() const { return normal_; }
+        Vec3D getNormal() const;
 
         // Calculate face area
         double calculateArea() const;
@@ -53,19 +123,102 @@ namespace czm_face
         // Calculate face perimeter
         double calculatePerimeter() const;
 
+        // Calculate axis-aligned bounding box of the vertices
+        BoundingBox calculateBoundingBox() const;
+
+        // Map reference coordinates to a point on the face. Triangles use the
+        // barycentric map v0 + xi (v1 - v0) + eta (v2 - v0) for xi + eta <= 1,
+        // quadrilaterals the bilinear map of the unit square [0,1]^2.
+        Vec3D mapReferencePoint(double xi, double eta) const;
+
+        // Area scale factor |dP/dxi x dP/deta| of mapReferencePoint at (xi, eta)
+        double mapJacobian(double xi, double eta) const;
+
+        // Get the reference shape of mapReferencePoint
+        ReferenceShape getReferenceShape() const
+        {
+            return (numVertices_ == 4) ? ReferenceShape::QUAD : ReferenceShape::TRIANGLE;
+        }
+
+        // Map a reference pattern (see ReferencePatternCache) onto the face,
+        // with the weights of generatePointGrid. Returns 0 if the pattern is
+        // for the other shape; otherwise same contract as generatePointGrid.
+        std::size_t mapReferencePattern(const ReferencePattern &pattern, Span<CZM_Point> output) const;
+        std::size_t mapReferencePattern(const ReferencePattern &pattern, Span<CZM_Point> output,
+                                        Span<double> weights) const;
+
+        // Map pattern points first, first + 1, ... onto the face, filling
+        // output (and weights, if not empty) up to the end of the pattern;
+        // returns the number of points written (0 for the other shape)
+        std::size_t mapReferencePattern(const ReferencePattern &pattern, std::size_t first,
+                                        Span<CZM_Point> output) const;
+        std::size_t mapReferencePattern(const ReferencePattern &pattern, std::size_t first,
+                                        Span<CZM_Point> output, Span<double> weights) const;
+
         // Generate point grid on the face
         std::vector<CZM_Point> generatePointGrid(int pointsPerEdge,
                                                  PointGenerationMethod method = PointGenerationMethod::EDGE_AND_INTERIOR) const;
 
+        // Generate point grid into a caller-provided buffer without allocating.
+        // Writes at most output.size() points and returns the number of points
+        // the method produces (size the buffer with countPoints).
+        std::size_t generatePointGrid(int pointsPerEdge, PointGenerationMethod method,
+                                      Span<CZM_Point> output) const;
+
+        // Generate points with the weight each point represents, computed in
+        // the same pass. GAUSS and LOBATTO give the quadrature weights on the
+        // face; PARAMETRIC_GRID gives the areas of the lattice dual cells (both
+        // sum to the face area). Edge points carry half of each adjacent edge
+        // segment (a length), grid points the area of their grid cell clipped
+        // to the XY projection of the face, the plane the grid lies in.
+        std::vector<CZM_Point> generatePointGrid(int pointsPerEdge, PointGenerationMethod method,
+                                                 std::vector<double> &weights) const;
+
+        // Generate points and weights into caller-provided buffers (weights
+        // must be at least as large as output); returns the number of points
+        std::size_t generatePointGrid(int pointsPerEdge, PointGenerationMethod method,
+                                      Span<CZM_Point> output, Span<double> weights) const;
+
+        // Count the points generatePointGrid would produce, without storing them
+        std::size_t countPoints(int pointsPerEdge,
+                                PointGenerationMethod method = PointGenerationMethod::EDGE_AND_INTERIOR) const;
+
         // Example method
         std::string getVersion() const;
 
-        // Generate points with equal area distribution
+        // Generate points with equal area distribution (default options)
         std::vector<CZM_Point> generateEqualAreaPoints(int numPoints) const;
+        std::vector<CZM_Point> generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options) const;
+
+        // Generate equal area points into a caller-provided buffer without
+        // allocating; same contract as the buffer overload of generatePointGrid
+        std::size_t generateEqualAreaPoints(int numPoints, Span<CZM_Point> output) const;
+        std::size_t generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options,
+                                            Span<CZM_Point> output) const;
+
+        // Generate equal area points with the tributary area of each point.
+        // CENTROIDAL maps a cached reference layout area-proportionally onto
+        // the face and gives the areas of the mapped cells, which tile the face
+        // (exactly for planar faces). RANDOM gives the clipped lattice cell of
+        // each point, scaled by the fraction of dropped candidates; STRATIFIED
+        // gives every point an equal share of the face area.
+        std::vector<CZM_Point> generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options,
+                                                       std::vector<double> &areas) const;
+        std::size_t generateEqualAreaPoints(int numPoints, const EqualAreaOptions &options,
+                                            Span<CZM_Point> output, Span<double> areas) const;
+
+        // Count the points generateEqualAreaPoints would produce
+        std::size_t countEqualAreaPoints(int numPoints) const;
+        std::size_t countEqualAreaPoints(int numPoints, const EqualAreaOptions &options) const;
 
     private:
-        // Calculate face normal
-        void calculateNormal();
+        // Calculate face normal into the cache
+        void calculateNormal() const;
+
+        // Calculate derived geometry from the vertices
+        double computeArea() const;
+        Vec3D computeCenter() const;
+        double computePerimeter() const;
 
         // Sort vertices for quadrilateral face
         void sortQuadVertices();
@@ -73,21 +226,69 @@ namespace czm_face
         // Create edges from vertices
         void createEdges();
 
-        // Generate points on edges
-        std::vector<CZM_Point> generateEdgePoints(int pointsPerEdge) const;
+        // Pass each generated point to sink(const CZM_Point &) instead of
+        // storing it; sinks taking (const CZM_Point &, double) also get the
+        // weight of the point
+        template <typename Sink>
+        void visitPointGrid(int pointsPerEdge, PointGenerationMethod method, Sink &&sink) const;
+        template <typename Sink>
+        void visitInteriorGridPoints(int pointsPerEdge, Sink &&sink) const;
+        template <typename Sink>
+        void visitUniformGridPoints(int pointsPerEdge, Sink &&sink) const;
+
+        // Pass points [begin, end) of a reference pattern mapped onto the face to the sink
+        template <typename Sink>
+        void visitReferencePattern(const ReferencePattern &pattern, std::size_t begin, std::size_t end,
+                                   Sink &&sink) const;
+
+        // Pass one reference pattern point (see ReferencePattern) mapped onto
+        // the face to the sink
+        template <typename Sink>
+        void visitReferencePoint(bool edgeParameters, double xi, double eta, int edge, double measure,
+                                 double measureXi, double measureEta, Sink &&sink) const;
+
+        // Pass each equal area candidate position to sink(const Vec3D &)
+        template <typename Sink>
+        void visitEqualAreaCandidates(int numPoints, Sink &&sink) const;
 
-        // Generate interior grid points
-        std::vector<CZM_Point> generateInteriorGridPoints(int pointsPerEdge) const;
+        // Pass numPoints area-uniform low-discrepancy positions to sink(const Vec3D &)
+        template <typename Sink>
+        void visitStratifiedPoints(int numPoints, const EqualAreaOptions &options, Sink &&sink) const;
 
-        // Generate uniform grid points
-        std::vector<CZM_Point> generateUniformGridPoints(int pointsPerEdge) const;
+        // Pass the points of an equal area selection to sink(const CZM_Point &)
+        // or, if the sink takes one, with their area to sink(const CZM_Point &, double)
+        template <typename Sink>
+        void visitEqualAreaPoints(int numPoints, const EqualAreaOptions &options, Sink &&sink) const;
+
+        // Pass numPoints centroidal Voronoi generators and their cell areas to
+        // sink(const Vec3D &, double)
+        template <typename Sink>
+        void visitCentroidalPoints(int numPoints, Sink &&sink) const;
+
+        // Area of the XY projection of the face inside an axis-aligned cell
+        double calculateClippedArea(const Vec3D &center, double sizeX, double sizeY) const;
 
         // Check if a point is inside the face
         bool isPointInside(const Vec3D &point) const;
 
-        std::vector<Vec3D> vertices_; // Face vertices
-        std::vector<Edge> edges_;     // Face edges
-        Vec3D normal_;                // Face normal
+        std::array<Vec3D, kMaxVertices> vertices_;            // Face vertices
+        std::array<EdgeIndices, kMaxVertices> edges_{};       // Face edges as vertex index pairs
+        std::uint8_t numVertices_ = 0;                        // Number of vertices (3 or 4)
+        mutable std::uint8_t dirty_ = 0;                      // Stale cached values (k*Dirty bits)
+        std::array<std::uint8_t, kMaxVertices> inputOrder_{}; // createFace index of each vertex
+        mutable Vec3D normal_;                                // Face normal
+        mutable double area_ = 0.0;                           // Face area
+        mutable Vec3D center_;                                // Face center
+        mutable double perimeter_ = 0.0;                      // Face perimeter
+
+        static constexpr std::uint8_t kNormalDirty = 1;
+        static constexpr std::uint8_t kAreaDirty = 2;
+        static constexpr std::uint8_t kCenterDirty = 4;
+        static constexpr std::uint8_t kPerimeterDirty = 8;
+        static constexpr std::uint8_t kAllDirty = kNormalDirty | kAreaDirty | kCenterDirty | kPerimeterDirty;
     };
 
+    static_assert(std::is_trivially_copyable<CzmFace>::value, "CzmFace must be trivially copyable");
+    static_assert(sizeof(CzmFace) <= 176, "CzmFace grew; batch paths stream whole faces through memory");
+
 } // namespace czm_face
\ No newline at end of file
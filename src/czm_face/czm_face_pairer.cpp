@@ -0,0 +1,147 @@
+#include "czm_face_pairer.hpp"
+#include "spatial_hash.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        struct KeyedFace
+        {
+            std::uint64_t key;
+            std::uint32_t face;
+
+            bool operator<(const KeyedFace &other) const
+            {
+                return key < other.key || (key == other.key && face < other.face);
+            }
+        };
+
+        // Check if every vertex of face a has a vertex of face b within tolerance
+        bool verticesMatch(const CzmFaceSet &faces, std::size_t a, std::size_t b, double toleranceSquared)
+        {
+            std::size_t count = faces.getNumVertices(a);
+            if (faces.getNumVertices(b) != count)
+                return false;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Vec3D va = faces.getVertex(a, i);
+                bool found = false;
+                for (std::size_t j = 0; j < count && !found; ++j)
+                {
+                    found = (faces.getVertex(b, j) - va).squaredLength() <= toleranceSquared;
+                }
+                if (!found)
+                    return false;
+            }
+            return true;
+        }
+
+        std::size_t grainSizeFor(std::size_t count, const ThreadPool &pool)
+        {
+            return std::max<std::size_t>(256, count / (static_cast<std::size_t>(pool.getNumThreads()) * 8));
+        }
+    }
+
+    CzmFacePairer::CzmFacePairer(const FacePairingOptions &options)
+        : options_(options)
+    {
+    }
+
+    std::vector<FacePair> CzmFacePairer::findPairs(const CzmFaceSet &faces, ThreadPool &pool) const
+    {
+        std::size_t numFaces = faces.size();
+        if (numFaces < 2)
+            return {};
+
+        std::vector<double> cx, cy, cz, nx, ny, nz;
+        faces.calculateCenters(cx, cy, cz);
+        faces.calculateNormals(nx, ny, nz);
+
+        // Cells at least twice the tolerance wide, but never so small that
+        // cell coordinates of the mesh extent overflow
+        double extent = 0.0;
+        for (std::size_t i = 0; i < numFaces; ++i)
+        {
+            extent = std::max({extent, std::fabs(cx[i]), std::fabs(cy[i]), std::fabs(cz[i])});
+        }
+        double cellSize = std::max(2.0 * options_.tolerance, extent * 1e-12);
+        if (cellSize <= 0.0)
+            cellSize = 1.0;
+        double inverseCell = 1.0 / cellSize;
+
+        auto cellOf = [&](std::size_t i)
+        { return quantizeToCell(cx[i], cy[i], cz[i], inverseCell); };
+
+        // Sorted (cell key, face) table replaces a shared hash map
+        std::vector<KeyedFace> table(numFaces);
+        std::size_t grainSize = grainSizeFor(numFaces, pool);
+        pool.parallelFor(numFaces, grainSize,
+                         [&](std::size_t begin, std::size_t end)
+                         {
+                             for (std::size_t i = begin; i < end; ++i)
+                             {
+                                 GridCell cell = cellOf(i);
+                                 table[i] = KeyedFace{hashCell(cell.x, cell.y, cell.z), static_cast<std::uint32_t>(i)};
+                             }
+                         });
+        std::sort(table.begin(), table.end());
+
+        // Each chunk collects the pairs of its faces with higher-numbered faces
+        double toleranceSquared = options_.tolerance * options_.tolerance;
+        std::size_t numChunks = (numFaces + grainSize - 1) / grainSize;
+        std::vector<std::vector<FacePair>> chunkPairs(numChunks);
+        pool.parallelFor(numFaces, grainSize,
+                         [&](std::size_t begin, std::size_t end)
+                         {
+                             std::vector<FacePair> &pairs = chunkPairs[begin / grainSize];
+                             for (std::size_t i = begin; i < end; ++i)
+                             {
+                                 GridCell cell = cellOf(i);
+                                 for (int dx = -1; dx <= 1; ++dx)
+                                 {
+                                     for (int dy = -1; dy <= 1; ++dy)
+                                     {
+                                         for (int dz = -1; dz <= 1; ++dz)
+                                         {
+                                             std::uint64_t key = hashCell(cell.x + dx, cell.y + dy, cell.z + dz);
+                                             auto range = std::equal_range(table.begin(), table.end(),
+                                                                           KeyedFace{key, 0},
+                                                                           [](const KeyedFace &a, const KeyedFace &b)
+                                                                           { return a.key < b.key; });
+                                             for (auto it = range.first; it != range.second; ++it)
+                                             {
+                                                 std::size_t j = it->face;
+                                                 if (j <= i || !verticesMatch(faces, i, j, toleranceSquared))
+                                                     continue;
+
+                                                 bool opposite = nx[i] * nx[j] + ny[i] * ny[j] + nz[i] * nz[j] < 0.0;
+                                                 if (options_.requireOppositeNormals && !opposite)
+                                                     continue;
+                                                 pairs.push_back(FacePair{static_cast<std::uint32_t>(i),
+                                                                          static_cast<std::uint32_t>(j), opposite});
+                                             }
+                                         }
+                                     }
+                                 }
+                             }
+                         });
+
+        // Neighbouring cells can hash to the same key, so drop duplicates
+        std::vector<FacePair> result;
+        for (auto &pairs : chunkPairs)
+        {
+            std::sort(pairs.begin(), pairs.end(), [](const FacePair &a, const FacePair &b)
+                      { return a.first < b.first || (a.first == b.first && a.second < b.second); });
+            auto last = std::unique(pairs.begin(), pairs.end(), [](const FacePair &a, const FacePair &b)
+                                    { return a.first == b.first && a.second == b.second; });
+            result.insert(result.end(), pairs.begin(), last);
+        }
+        return result;
+    }
+
+} // namespace czm_face
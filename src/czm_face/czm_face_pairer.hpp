@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "czm_face_set.hpp"
+#include "thread_pool.hpp"
+
+namespace czm_face
+{
+
+    // Two coincident faces of a face set (first < second)
+    struct FacePair
+    {
+        std::uint32_t first;
+        std::uint32_t second;
+        bool oppositeNormals; // Normals point in opposite directions
+    };
+
+    // Options of the face pairing
+    struct FacePairingOptions
+    {
+        // Maximum distance between matching vertices
+        double tolerance = 1e-9;
+
+        // Only report pairs whose normals point in opposite directions. Quads
+        // are reordered by CzmFace/CzmFaceSet into a canonical winding, so
+        // coincident quads always have equal normals; leave this off when
+        // pairing quads and use FacePair::oppositeNormals for triangles.
+        bool requireOppositeNormals = false;
+    };
+
+    // Finds coincident face pairs, e.g. the top and bottom faces of cohesive
+    // elements along grain boundaries. Face centroids are quantized to a grid
+    // of cells at least twice the tolerance wide and sorted by cell key;
+    // every face then only compares its vertices against faces in the 27
+    // surrounding cells. Key computation and candidate search run in parallel.
+    class CzmFacePairer
+    {
+    public:
+        explicit CzmFacePairer(const FacePairingOptions &options = FacePairingOptions());
+        ~CzmFacePairer() = default;
+
+        // Allow copying
+        CzmFacePairer(const CzmFacePairer &) = default;
+        CzmFacePairer &operator=(const CzmFacePairer &) = default;
+
+        // Allow moving
+        CzmFacePairer(CzmFacePairer &&) = default;
+        CzmFacePairer &operator=(CzmFacePairer &&) = default;
+
+        // Get pairing options
+        const FacePairingOptions &getOptions() const { return options_; }
+
+        // Find all coincident face pairs, sorted by (first, second). Faces are
+        // coincident if they have the same number of vertices and every
+        // vertex has a match within the tolerance, regardless of order.
+        std::vector<FacePair> findPairs(const CzmFaceSet &faces,
+                                        ThreadPool &pool = ThreadPool::getDefault()) const;
+
+    private:
+        FacePairingOptions options_; // Pairing options
+    };
+
+} // namespace czm_face
@@ -0,0 +1,190 @@
+#include "czm_face_set.hpp"
+#include <cmath>
+
+namespace czm_face
+{
+
+    void CzmFaceSet::reserve(std::size_t numFaces, std::size_t numVertices)
+    {
+        x_.reserve(numVertices);
+        y_.reserve(numVertices);
+        z_.reserve(numVertices);
+        offsets_.reserve(numFaces + 1);
+    }
+
+    bool CzmFaceSet::addFace(const std::vector<Vec3D> &vertices)
+    {
+        return addFace(vertices.data(), vertices.size());
+    }
+
+    bool CzmFaceSet::addFace(const Vec3D *vertices, std::size_t count)
+    {
+        // Check if we have 3 or 4 vertices
+        if (count != 3 && count != 4)
+        {
+            return false;
+        }
+
+        Vec3D face[4];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            face[i] = vertices[i];
+        }
+
+        // For quadrilateral, sort vertices
+        if (count == 4)
+        {
+            orderQuadVertices(face);
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            x_.push_back(face[i].comp[0]);
+            y_.push_back(face[i].comp[1]);
+            z_.push_back(face[i].comp[2]);
+        }
+        offsets_.push_back(x_.size());
+
+        return true;
+    }
+
+    bool CzmFaceSet::addFace(const CzmFace &face)
+    {
+        Span<const Vec3D> vertices = face.getVertices();
+        return addFace(vertices.data(), vertices.size());
+    }
+
+    bool CzmFaceSet::assign(Span<const double> x, Span<const double> y, Span<const double> z,
+                            Span<const std::size_t> offsets)
+    {
+        if (y.size() != x.size() || z.size() != x.size() || offsets.empty() ||
+            offsets[0] != 0 || offsets[offsets.size() - 1] != x.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+        {
+            std::size_t count = offsets[i + 1] - offsets[i];
+            if (offsets[i + 1] < offsets[i] || (count != 3 && count != 4))
+            {
+                return false;
+            }
+        }
+
+        x_.assign(x.begin(), x.end());
+        y_.assign(y.begin(), y.end());
+        z_.assign(z.begin(), z.end());
+        offsets_.assign(offsets.begin(), offsets.end());
+        return true;
+    }
+
+    void CzmFaceSet::clear()
+    {
+        x_.clear();
+        y_.clear();
+        z_.clear();
+        offsets_.assign(1, 0);
+    }
+
+    Vec3D CzmFaceSet::getVertex(std::size_t face, std::size_t vertex) const
+    {
+        std::size_t index = offsets_[face] + vertex;
+        return Vec3D(x_[index], y_[index], z_[index]);
+    }
+
+    CzmFace CzmFaceSet::getFace(std::size_t face) const
+    {
+        Vec3D vertices[CzmFace::kMaxVertices];
+        std::size_t count = getNumVertices(face);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            vertices[i] = getVertex(face, i);
+        }
+
+        CzmFace result;
+        result.createFace(vertices, count);
+        return result;
+    }
+
+    FaceGeometryView CzmFaceSet::getView() const
+    {
+        FaceGeometryView view;
+        view.x = x_.data();
+        view.y = y_.data();
+        view.z = z_.data();
+        view.offsets = offsets_.data();
+        view.numFaces = size();
+        return view;
+    }
+
+    std::vector<double> CzmFaceSet::calculateAreas() const
+    {
+        std::vector<double> areas(size());
+        computeFaceAreas(getView(), areas.data());
+        return areas;
+    }
+
+    std::vector<Vec3D> CzmFaceSet::calculateCenters() const
+    {
+        std::vector<double> cx, cy, cz;
+        calculateCenters(cx, cy, cz);
+
+        std::vector<Vec3D> centers(size());
+        for (std::size_t f = 0; f < centers.size(); ++f)
+        {
+            centers[f] = Vec3D(cx[f], cy[f], cz[f]);
+        }
+        return centers;
+    }
+
+    void CzmFaceSet::calculateCenters(std::vector<double> &cx, std::vector<double> &cy, std::vector<double> &cz) const
+    {
+        cx.resize(size());
+        cy.resize(size());
+        cz.resize(size());
+        computeFaceCenters(getView(), cx.data(), cy.data(), cz.data());
+    }
+
+    std::vector<double> CzmFaceSet::calculatePerimeters() const
+    {
+        std::vector<double> perimeters(size());
+        for (std::size_t f = 0; f < perimeters.size(); ++f)
+        {
+            std::size_t begin = offsets_[f];
+            std::size_t end = offsets_[f + 1];
+            double perimeter = 0.0;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t next = (i + 1 < end) ? i + 1 : begin;
+                double dx = x_[next] - x_[i];
+                double dy = y_[next] - y_[i];
+                double dz = z_[next] - z_[i];
+                perimeter += std::sqrt(dx * dx + dy * dy + dz * dz);
+            }
+            perimeters[f] = perimeter;
+        }
+        return perimeters;
+    }
+
+    std::vector<Vec3D> CzmFaceSet::calculateNormals() const
+    {
+        std::vector<double> nx, ny, nz;
+        calculateNormals(nx, ny, nz);
+
+        std::vector<Vec3D> normals(size());
+        for (std::size_t f = 0; f < normals.size(); ++f)
+        {
+            normals[f] = Vec3D(nx[f], ny[f], nz[f]);
+        }
+        return normals;
+    }
+
+    void CzmFaceSet::calculateNormals(std::vector<double> &nx, std::vector<double> &ny, std::vector<double> &nz) const
+    {
+        nx.resize(size());
+        ny.resize(size());
+        nz.resize(size());
+        computeFaceNormals(getView(), nx.data(), ny.data(), nz.data());
+    }
+
+} // namespace czm_face
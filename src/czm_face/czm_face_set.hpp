@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "vec3d/vec3d.h"
+#include "czm_face.hpp"
+#include "face_kernels.hpp"
+#include "span.hpp"
+
+namespace czm_face
+{
+
+    // Container for large numbers of triangular and quadrilateral faces.
+    // Vertex coordinates of all faces are stored in contiguous structure-of-arrays
+    // form (x[], y[], z[]); the vertices of face i occupy the index range
+    // [offsets[i], offsets[i + 1]).
+    class CzmFaceSet
+    {
+    public:
+        CzmFaceSet() = default;
+        ~CzmFaceSet() = default;
+
+        // Allow copying
+        CzmFaceSet(const CzmFaceSet &) = default;
+        CzmFaceSet &operator=(const CzmFaceSet &) = default;
+
+        // Allow moving
+        CzmFaceSet(CzmFaceSet &&) = default;
+        CzmFaceSet &operator=(CzmFaceSet &&) = default;
+
+        // Reserve storage for a number of faces and their total vertex count
+        void reserve(std::size_t numFaces, std::size_t numVertices);
+
+        // Append a face from 3 or 4 vertices (quads are sorted like CzmFace)
+        bool addFace(const std::vector<Vec3D> &vertices);
+        bool addFace(const Vec3D *vertices, std::size_t count);
+        bool addFace(const CzmFace &face);
+
+        // Replace all faces with packed coordinates and offsets (same layout
+        // as the raw arrays; quad vertices are taken as already sorted).
+        // Returns false and leaves the set unchanged if the offsets do not
+        // start at 0, end at the coordinate count and give 3 or 4 vertices.
+        bool assign(Span<const double> x, Span<const double> y, Span<const double> z,
+                    Span<const std::size_t> offsets);
+
+        // Remove all faces
+        void clear();
+
+        // Get number of faces
+        std::size_t size() const { return offsets_.size() - 1; }
+        bool empty() const { return size() == 0; }
+
+        // Get total number of stored vertices
+        std::size_t getTotalVertices() const { return x_.size(); }
+
+        // Get number of vertices of a face
+        std::size_t getNumVertices(std::size_t face) const { return offsets_[face + 1] - offsets_[face]; }
+
+        // Get a vertex of a face
+        Vec3D getVertex(std::size_t face, std::size_t vertex) const;
+
+        // Get a face as a standalone CzmFace
+        CzmFace getFace(std::size_t face) const;
+
+        // Get raw coordinate and offset arrays
+        const std::vector<double> &getX() const { return x_; }
+        const std::vector<double> &getY() const { return y_; }
+        const std::vector<double> &getZ() const { return z_; }
+        const std::vector<std::size_t> &getOffsets() const { return offsets_; }
+
+        // Get a view of the packed coordinates for the batch kernels
+        FaceGeometryView getView() const;
+
+        // Calculate area of every face
+        std::vector<double> calculateAreas() const;
+
+        // Calculate center of every face
+        std::vector<Vec3D> calculateCenters() const;
+        void calculateCenters(std::vector<double> &cx, std::vector<double> &cy, std::vector<double> &cz) const;
+
+        // Calculate perimeter of every face
+        std::vector<double> calculatePerimeters() const;
+
+        // Calculate unit normal of every face
+        std::vector<Vec3D> calculateNormals() const;
+        void calculateNormals(std::vector<double> &nx, std::vector<double> &ny, std::vector<double> &nz) const;
+
+    private:
+        std::vector<double> x_;                 // Vertex x coordinates
+        std::vector<double> y_;                 // Vertex y coordinates
+        std::vector<double> z_;                 // Vertex z coordinates
+        std::vector<std::size_t> offsets_ = {0}; // Per-face offsets into coordinate arrays
+    };
+
+} // namespace czm_face
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "vec3d/vec3d.h"
-#include "edge.hpp"
 
 namespace czm_face
 {
@@ -33,16 +32,16 @@ namespace czm_face
         // Get point type
         PointType getType() const { return type_; }
 
-        // Set associated edge (for edge points)
-        void setEdge(const Edge *edge) { edge_ = edge; }
+        // Set index of the associated face edge (for edge points)
+        void setEdgeIndex(int edgeIndex) { edgeIndex_ = edgeIndex; }
 
-        // Get associated edge (for edge points)
-        const Edge *getEdge() const { return edge_; }
+        // Get index of the associated face edge (-1 for interior points)
+        int getEdgeIndex() const { return edgeIndex_; }
 
     private:
-        Vec3D position_;             // Point position
-        PointType type_;             // Point type (edge or interior)
-        const Edge *edge_ = nullptr; // Associated edge (for edge points)
+        Vec3D position_;     // Point position
+        PointType type_;     // Point type (edge or interior)
+        int edgeIndex_ = -1; // Associated face edge (for edge points)
     };
 
 } // namespace czm_face
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "czm_point_cloud.hpp"
+#include <algorithm>
+
+namespace czm_face
+{
+
+    CzmPointCloud CzmPointCloud::fromPoints(Span<const CZM_Point> points, std::uint32_t faceId)
+    {
+        CzmPointCloud cloud;
+        cloud.append(points, faceId);
+        return cloud;
+    }
+
+    void CzmPointCloud::reserve(std::size_t numPoints)
+    {
+        x_.reserve(numPoints);
+        y_.reserve(numPoints);
+        z_.reserve(numPoints);
+        typeBits_.reserve((numPoints + 63) / 64);
+        faceIds_.reserve(numPoints);
+        edgeIndices_.reserve(numPoints);
+    }
+
+    void CzmPointCloud::clear()
+    {
+        x_.clear();
+        y_.clear();
+        z_.clear();
+        typeBits_.clear();
+        faceIds_.clear();
+        edgeIndices_.clear();
+    }
+
+    void CzmPointCloud::append(const CZM_Point &point, std::uint32_t faceId)
+    {
+        std::size_t i = x_.size();
+        if (i % 64 == 0)
+        {
+            typeBits_.push_back(0);
+        }
+        if (point.getType() == PointType::EDGE_POINT)
+        {
+            typeBits_[i / 64] |= std::uint64_t(1) << (i % 64);
+        }
+
+        const Vec3D &position = point.getPosition();
+        x_.push_back(position.comp[0]);
+        y_.push_back(position.comp[1]);
+        z_.push_back(position.comp[2]);
+        faceIds_.push_back(faceId);
+        edgeIndices_.push_back(static_cast<std::int8_t>(point.getEdgeIndex()));
+    }
+
+    void CzmPointCloud::append(Span<const CZM_Point> points, std::uint32_t faceId)
+    {
+        // Grow geometrically so appending face by face stays linear
+        std::size_t needed = size() + points.size();
+        if (needed > x_.capacity())
+        {
+            reserve(std::max(needed, 2 * x_.capacity()));
+        }
+        for (const auto &point : points)
+        {
+            append(point, faceId);
+        }
+    }
+
+    bool CzmPointCloud::assign(Span<const double> x, Span<const double> y, Span<const double> z,
+                               Span<const std::uint64_t> typeBits, Span<const std::uint32_t> faceIds,
+                               Span<const std::int8_t> edgeIndices)
+    {
+        std::size_t count = x.size();
+        if (y.size() != count || z.size() != count || typeBits.size() != (count + 63) / 64 ||
+            faceIds.size() != count || edgeIndices.size() != count)
+        {
+            return false;
+        }
+
+        x_.assign(x.begin(), x.end());
+        y_.assign(y.begin(), y.end());
+        z_.assign(z.begin(), z.end());
+        typeBits_.assign(typeBits.begin(), typeBits.end());
+        faceIds_.assign(faceIds.begin(), faceIds.end());
+        edgeIndices_.assign(edgeIndices.begin(), edgeIndices.end());
+        return true;
+    }
+
+    CZM_Point CzmPointCloud::getPoint(std::size_t i) const
+    {
+        CZM_Point point(getPosition(i), getType(i));
+        point.setEdgeIndex(edgeIndices_[i]);
+        return point;
+    }
+
+    std::vector<CZM_Point> CzmPointCloud::toPoints() const
+    {
+        std::vector<CZM_Point> points;
+        points.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            points.push_back(getPoint(i));
+        }
+        return points;
+    }
+
+} // namespace czm_face
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "vec3d/vec3d.h"
+#include "czm_point.hpp"
+#include "span.hpp"
+
+namespace czm_face
+{
+
+    // Compact structure-of-arrays storage for large numbers of generated points.
+    // Coordinates live in separate x/y/z arrays, point types in a packed
+    // bitfield (1 bit per point) and the owning edge as a (face id, edge index)
+    // pair instead of a pointer, so the data can be copied and serialized freely.
+    class CzmPointCloud
+    {
+    public:
+        CzmPointCloud() = default;
+        ~CzmPointCloud() = default;
+
+        // Allow copying
+        CzmPointCloud(const CzmPointCloud &) = default;
+        CzmPointCloud &operator=(const CzmPointCloud &) = default;
+
+        // Allow moving
+        CzmPointCloud(CzmPointCloud &&) = default;
+        CzmPointCloud &operator=(CzmPointCloud &&) = default;
+
+        // Create a point cloud from points generated on one face
+        static CzmPointCloud fromPoints(Span<const CZM_Point> points, std::uint32_t faceId);
+
+        // Reserve storage for a number of points
+        void reserve(std::size_t numPoints);
+
+        // Remove all points
+        void clear();
+
+        // Append a point generated on a face
+        void append(const CZM_Point &point, std::uint32_t faceId);
+
+        // Append points generated on a face
+        void append(Span<const CZM_Point> points, std::uint32_t faceId);
+
+        // Replace all points with raw arrays (same layout as the getters).
+        // Returns false and leaves the cloud unchanged if the sizes differ.
+        bool assign(Span<const double> x, Span<const double> y, Span<const double> z,
+                    Span<const std::uint64_t> typeBits, Span<const std::uint32_t> faceIds,
+                    Span<const std::int8_t> edgeIndices);
+
+        // Get number of points
+        std::size_t size() const { return x_.size(); }
+        bool empty() const { return x_.empty(); }
+
+        // Get point data
+        Vec3D getPosition(std::size_t i) const { return Vec3D(x_[i], y_[i], z_[i]); }
+        PointType getType(std::size_t i) const
+        {
+            return ((typeBits_[i / 64] >> (i % 64)) & 1u) ? PointType::EDGE_POINT : PointType::INTERIOR_POINT;
+        }
+        std::uint32_t getFaceId(std::size_t i) const { return faceIds_[i]; }
+        int getEdgeIndex(std::size_t i) const { return edgeIndices_[i]; }
+
+        // Convert one point back to a CZM_Point
+        CZM_Point getPoint(std::size_t i) const;
+
+        // Convert all points back to CZM_Points
+        std::vector<CZM_Point> toPoints() const;
+
+        // Get raw arrays
+        const std::vector<double> &getX() const { return x_; }
+        const std::vector<double> &getY() const { return y_; }
+        const std::vector<double> &getZ() const { return z_; }
+        const std::vector<std::uint64_t> &getTypeBits() const { return typeBits_; }
+        const std::vector<std::uint32_t> &getFaceIds() const { return faceIds_; }
+        const std::vector<std::int8_t> &getEdgeIndices() const { return edgeIndices_; }
+
+    private:
+        std::vector<double> x_;                // Point x coordinates
+        std::vector<double> y_;                // Point y coordinates
+        std::vector<double> z_;                // Point z coordinates
+        std::vector<std::uint64_t> typeBits_;  // Bit i set for edge points
+        std::vector<std::uint32_t> faceIds_;   // Face each point was generated on
+        std::vector<std::int8_t> edgeIndices_; // Face-local edge index (-1 for interior points)
+    };
+
+} // namespace czm_face
@@ -12,9 +12,9 @@ namespace czm_face
         Edge(const Vec3D &start, const Vec3D &end);
         ~Edge() = default;
 
-        // Prevent copying
-        Edge(const Edge &) = delete;
-        Edge &operator=(const Edge &) = delete;
+        // Allow copying
+        Edge(const Edge &) = default;
+        Edge &operator=(const Edge &) = default;
 
         // Allow moving
         Edge(Edge &&) = default;
@@ -0,0 +1,365 @@
+#include "face_bvh.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        constexpr int kSahBins = 16;
+
+        // Deeper subtrees become leaves so traversal stacks stay bounded
+        constexpr int kMaxDepth = 48;
+        constexpr int kStackSize = kMaxDepth + 2;
+
+        // Closest point to p on triangle abc (Ericson, Real-Time Collision Detection 5.1.5)
+        Vec3D closestPointOnTriangle(const Vec3D &p, const Vec3D &a, const Vec3D &b, const Vec3D &c)
+        {
+            Vec3D ab = b - a, ac = c - a, ap = p - a;
+            double d1 = ab.dot(ap), d2 = ac.dot(ap);
+            if (d1 <= 0.0 && d2 <= 0.0)
+                return a;
+
+            Vec3D bp = p - b;
+            double d3 = ab.dot(bp), d4 = ac.dot(bp);
+            if (d3 >= 0.0 && d4 <= d3)
+                return b;
+
+            double vc = d1 * d4 - d3 * d2;
+            if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+                return a + (d1 / (d1 - d3)) * ab;
+
+            Vec3D cp = p - c;
+            double d5 = ab.dot(cp), d6 = ac.dot(cp);
+            if (d6 >= 0.0 && d5 <= d6)
+                return c;
+
+            double vb = d5 * d2 - d1 * d6;
+            if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+                return a + (d2 / (d2 - d6)) * ac;
+
+            double va = d3 * d6 - d5 * d4;
+            if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+                return b + ((d4 - d3) / ((d4 - d3) + (d5 - d6))) * (c - b);
+
+            double denom = 1.0 / (va + vb + vc);
+            return a + (vb * denom) * ab + (vc * denom) * ac;
+        }
+
+        // Squared distance from a point to a face (quads as two triangles)
+        double squaredDistanceToFace(const Vec3D &p, const CzmFace &face)
+        {
+            if (face.getNumVertices() < 3)
+                return std::numeric_limits<double>::max();
+
+            const Vec3D &v0 = face.getVertex(0);
+            double distance = (closestPointOnTriangle(p, v0, face.getVertex(1), face.getVertex(2)) - p).squaredLength();
+            if (face.getNumVertices() == 4)
+            {
+                Vec3D q = closestPointOnTriangle(p, v0, face.getVertex(2), face.getVertex(3));
+                distance = std::min(distance, (q - p).squaredLength());
+            }
+            return distance;
+        }
+
+        std::size_t grainSizeFor(std::size_t count, const ThreadPool &pool)
+        {
+            return std::max<std::size_t>(64, count / (static_cast<std::size_t>(pool.getNumThreads()) * 8));
+        }
+    }
+
+    void FaceBvh::build(const CzmFaceSet &faces)
+    {
+        std::vector<CzmFace> copies(faces.size());
+        for (std::size_t i = 0; i < faces.size(); ++i)
+        {
+            copies[i] = faces.getFace(i);
+        }
+        build(Span<const CzmFace>(copies));
+    }
+
+    void FaceBvh::build(Span<const CzmFace> faces)
+    {
+        faces_.assign(faces.begin(), faces.end());
+        boxes_.clear();
+        testers_.clear();
+        nodes_.clear();
+        faceIndices_.clear();
+        if (faces_.empty())
+            return;
+
+        boxes_.resize(faces_.size());
+        std::vector<Vec3D> centroids(faces_.size());
+        testers_.reserve(faces_.size());
+        faceIndices_.resize(faces_.size());
+        for (std::size_t i = 0; i < faces_.size(); ++i)
+        {
+            // Faces moved with updateVertices compute their geometry on first
+            // query; do it now so parallel queries only read the faces
+            faces_[i].refreshGeometry();
+            boxes_[i] = faces_[i].calculateBoundingBox();
+            centroids[i] = boxes_[i].getCenter();
+            testers_.emplace_back(faces_[i]);
+            faceIndices_[i] = static_cast<std::uint32_t>(i);
+        }
+
+        // A binary tree with at most one face per leaf has 2N - 1 nodes
+        nodes_.reserve(2 * faces_.size());
+        buildNode(centroids, 0, static_cast<std::uint32_t>(faces_.size()), 0);
+    }
+
+    std::uint32_t FaceBvh::buildNode(const std::vector<Vec3D> &centroids, std::uint32_t begin, std::uint32_t end,
+                                     int depth)
+    {
+        std::uint32_t nodeIndex = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+
+        BoundingBox bounds, centroidBounds;
+        for (std::uint32_t i = begin; i < end; ++i)
+        {
+            bounds.expand(boxes_[faceIndices_[i]]);
+            centroidBounds.expand(centroids[faceIndices_[i]]);
+        }
+        nodes_[nodeIndex].bounds = bounds;
+
+        std::uint32_t count = end - begin;
+        auto makeLeaf = [&]
+        {
+            nodes_[nodeIndex].offset = begin;
+            nodes_[nodeIndex].count = count;
+            return nodeIndex;
+        };
+        if (count <= 1 || depth >= kMaxDepth)
+            return makeLeaf();
+
+        // Binned SAH: cost of a split is N_left * A_left + N_right * A_right,
+        // compared against N * A for keeping all faces in one leaf
+        double bestCost = std::numeric_limits<double>::max();
+        int bestAxis = -1;
+        int bestBin = 0;
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            double lo = centroidBounds.min.comp[axis];
+            double extent = centroidBounds.max.comp[axis] - lo;
+            if (extent <= 0.0)
+                continue;
+
+            BoundingBox binBounds[kSahBins];
+            std::uint32_t binCounts[kSahBins] = {};
+            double scale = kSahBins / extent;
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                std::uint32_t face = faceIndices_[i];
+                int bin = std::min(kSahBins - 1, static_cast<int>((centroids[face].comp[axis] - lo) * scale));
+                binBounds[bin].expand(boxes_[face]);
+                ++binCounts[bin];
+            }
+
+            // Sweep from the right to get suffix areas, then from the left
+            double rightArea[kSahBins];
+            std::uint32_t rightCount[kSahBins];
+            BoundingBox accumulated;
+            std::uint32_t accumulatedCount = 0;
+            for (int bin = kSahBins - 1; bin > 0; --bin)
+            {
+                accumulated.expand(binBounds[bin]);
+                accumulatedCount += binCounts[bin];
+                rightArea[bin] = accumulated.getSurfaceArea();
+                rightCount[bin] = accumulatedCount;
+            }
+
+            accumulated = BoundingBox();
+            accumulatedCount = 0;
+            for (int bin = 0; bin < kSahBins - 1; ++bin)
+            {
+                accumulated.expand(binBounds[bin]);
+                accumulatedCount += binCounts[bin];
+                if (accumulatedCount == 0 || rightCount[bin + 1] == 0)
+                    continue;
+
+                double cost = accumulatedCount * accumulated.getSurfaceArea() +
+                              rightCount[bin + 1] * rightArea[bin + 1];
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                }
+            }
+        }
+
+        double leafCost = count * bounds.getSurfaceArea();
+        if (bestAxis < 0 || (count <= kMaxLeafFaces && bestCost >= leafCost))
+            return makeLeaf();
+
+        // Partition the face range at the chosen bin boundary
+        double lo = centroidBounds.min.comp[bestAxis];
+        double scale = kSahBins / (centroidBounds.max.comp[bestAxis] - lo);
+        auto middle = std::partition(faceIndices_.begin() + begin, faceIndices_.begin() + end,
+                                     [&](std::uint32_t face)
+                                     {
+                                         int bin = std::min(kSahBins - 1, static_cast<int>((centroids[face].comp[bestAxis] - lo) * scale));
+                                         return bin <= bestBin;
+                                     });
+        std::uint32_t split = static_cast<std::uint32_t>(middle - faceIndices_.begin());
+
+        buildNode(centroids, begin, split, depth + 1);
+        std::uint32_t right = buildNode(centroids, split, end, depth + 1);
+        nodes_[nodeIndex].offset = right;
+        nodes_[nodeIndex].count = 0;
+        return nodeIndex;
+    }
+
+    int FaceBvh::findNearestFace(const Vec3D &point, double *distance) const
+    {
+        if (nodes_.empty())
+            return -1;
+
+        int best = -1;
+        double bestDistance = std::numeric_limits<double>::max();
+
+        // Depth-first traversal, visiting the closer child first and pruning
+        // subtrees whose box is farther than the best face found so far
+        std::uint32_t stack[kStackSize];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const BvhNode &node = nodes_[stack[--top]];
+            if (node.bounds.squaredDistance(point) >= bestDistance)
+                continue;
+
+            if (node.isLeaf())
+            {
+                for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i)
+                {
+                    std::uint32_t face = faceIndices_[i];
+                    double d = squaredDistanceToFace(point, faces_[face]);
+                    if (d < bestDistance || (d == bestDistance && static_cast<int>(face) < best))
+                    {
+                        bestDistance = d;
+                        best = static_cast<int>(face);
+                    }
+                }
+                continue;
+            }
+
+            std::uint32_t left = static_cast<std::uint32_t>(&node - nodes_.data()) + 1;
+            std::uint32_t right = node.offset;
+            double leftDistance = nodes_[left].bounds.squaredDistance(point);
+            double rightDistance = nodes_[right].bounds.squaredDistance(point);
+            if (leftDistance < rightDistance)
+                std::swap(left, right);
+            stack[top++] = left;
+            stack[top++] = right;
+        }
+
+        if (distance)
+            *distance = std::sqrt(bestDistance);
+        return best;
+    }
+
+    int FaceBvh::findContainingFace(const Vec3D &point, double tolerance) const
+    {
+        if (nodes_.empty())
+            return -1;
+
+        int best = -1;
+        double bestDistance = std::numeric_limits<double>::max();
+
+        BoundingBox query;
+        query.expand(point);
+        query.inflate(tolerance);
+
+        std::uint32_t stack[kStackSize];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            std::uint32_t index = stack[--top];
+            const BvhNode &node = nodes_[index];
+            if (!node.bounds.overlaps(query))
+                continue;
+
+            if (!node.isLeaf())
+            {
+                stack[top++] = node.offset;
+                stack[top++] = index + 1;
+                continue;
+            }
+
+            for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i)
+            {
+                std::uint32_t face = faceIndices_[i];
+                double planeDistance = std::fabs((point - faces_[face].getVertex(0)).dot(faces_[face].getNormal()));
+                if (planeDistance > tolerance || !testers_[face].contains(point))
+                    continue;
+
+                if (planeDistance < bestDistance || (planeDistance == bestDistance && static_cast<int>(face) < best))
+                {
+                    bestDistance = planeDistance;
+                    best = static_cast<int>(face);
+                }
+            }
+        }
+        return best;
+    }
+
+    void FaceBvh::findOverlappingFaces(const BoundingBox &box, std::vector<std::uint32_t> &result) const
+    {
+        if (nodes_.empty())
+            return;
+
+        std::uint32_t stack[kStackSize];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            std::uint32_t index = stack[--top];
+            const BvhNode &node = nodes_[index];
+            if (!node.bounds.overlaps(box))
+                continue;
+
+            if (!node.isLeaf())
+            {
+                stack[top++] = node.offset;
+                stack[top++] = index + 1;
+                continue;
+            }
+
+            for (std::uint32_t i = node.offset; i < node.offset + node.count; ++i)
+            {
+                std::uint32_t face = faceIndices_[i];
+                if (boxes_[face].overlaps(box))
+                    result.push_back(face);
+            }
+        }
+    }
+
+    std::vector<int> FaceBvh::findNearestFaces(Span<const Vec3D> points, ThreadPool &pool) const
+    {
+        std::vector<int> result(points.size(), -1);
+        pool.parallelFor(points.size(), grainSizeFor(points.size(), pool),
+                         [&](std::size_t begin, std::size_t end)
+                         {
+                             for (std::size_t i = begin; i < end; ++i)
+                                 result[i] = findNearestFace(points[i]);
+                         });
+        return result;
+    }
+
+    std::vector<int> FaceBvh::findContainingFaces(Span<const Vec3D> points, double tolerance, ThreadPool &pool) const
+    {
+        std::vector<int> result(points.size(), -1);
+        pool.parallelFor(points.size(), grainSizeFor(points.size(), pool),
+                         [&](std::size_t begin, std::size_t end)
+                         {
+                             for (std::size_t i = begin; i < end; ++i)
+                                 result[i] = findContainingFace(points[i], tolerance);
+                         });
+        return result;
+    }
+
+} // namespace czm_face
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "vec3d/vec3d.h"
+#include "bounding_box.hpp"
+#include "czm_face.hpp"
+#include "czm_face_set.hpp"
+#include "face_inside_tester.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+namespace czm_face
+{
+
+    // Node of a flattened bounding volume hierarchy. Nodes are stored depth
+    // first: the left child of an inner node follows it directly and
+    // offset is the index of its right child. For leaves offset is the first
+    // entry of the face index array and count the number of faces.
+    struct BvhNode
+    {
+        BoundingBox bounds;
+        std::uint32_t offset = 0; // Right child (inner) or first face index (leaf)
+        std::uint32_t count = 0;  // Number of faces (0 for inner nodes)
+
+        bool isLeaf() const { return count > 0; }
+    };
+
+    // Bounding volume hierarchy over a set of faces, built with the binned
+    // surface area heuristic and stored as a flat node array. Answers
+    // nearest-face, containing-face and box-overlap queries in O(log N)
+    // per query instead of looping over every face.
+    class FaceBvh
+    {
+    public:
+        // Maximum number of faces in a leaf
+        static constexpr std::uint32_t kMaxLeafFaces = 4;
+
+        FaceBvh() = default;
+        ~FaceBvh() = default;
+
+        // Allow copying
+        FaceBvh(const FaceBvh &) = default;
+        FaceBvh &operator=(const FaceBvh &) = default;
+
+        // Allow moving
+        FaceBvh(FaceBvh &&) = default;
+        FaceBvh &operator=(FaceBvh &&) = default;
+
+        // Build the hierarchy over a set of faces (replaces any previous build)
+        void build(Span<const CzmFace> faces);
+        void build(const CzmFaceSet &faces);
+
+        // Get number of indexed faces
+        std::size_t size() const { return faces_.size(); }
+        bool empty() const { return faces_.empty(); }
+
+        // Get the flat node array (node 0 is the root)
+        const std::vector<BvhNode> &getNodes() const { return nodes_; }
+
+        // Find the face closest to a point; returns -1 for an empty hierarchy.
+        // The distance to that face is stored in distance if given.
+        int findNearestFace(const Vec3D &point, double *distance = nullptr) const;
+
+        // Find a face containing a point within tolerance of its plane; among
+        // several candidates the one with the closest plane wins. Returns -1
+        // if no face contains the point.
+        int findContainingFace(const Vec3D &point, double tolerance) const;
+
+        // Append the indices of all faces whose bounding box overlaps box
+        void findOverlappingFaces(const BoundingBox &box, std::vector<std::uint32_t> &result) const;
+
+        // Batched queries over many points, run in parallel
+        std::vector<int> findNearestFaces(Span<const Vec3D> points,
+                                          ThreadPool &pool = ThreadPool::getDefault()) const;
+        std::vector<int> findContainingFaces(Span<const Vec3D> points, double tolerance,
+                                             ThreadPool &pool = ThreadPool::getDefault()) const;
+
+    private:
+        // Build the subtree over faceIndices_[begin, end) and return its node index
+        std::uint32_t buildNode(const std::vector<Vec3D> &centroids, std::uint32_t begin, std::uint32_t end,
+                                int depth);
+
+        std::vector<CzmFace> faces_;             // Indexed faces in input order
+        std::vector<BoundingBox> boxes_;         // Per-face bounding boxes
+        std::vector<FaceInsideTester> testers_;  // Per-face inside tests
+        std::vector<BvhNode> nodes_;             // Flattened hierarchy
+        std::vector<std::uint32_t> faceIndices_; // Leaf face ranges
+    };
+
+} // namespace czm_face
@@ -0,0 +1,556 @@
+#include "face_inside_tester.hpp"
+#include "simd_dispatch.hpp"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CZM_FACE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace czm_face
+{
+
+    static_assert(sizeof(Vec3D) == 3 * sizeof(double), "Vec3D must be three packed doubles");
+    static_assert(sizeof(Vec3f) == 3 * sizeof(float), "Vec3f must be three packed floats");
+
+    namespace
+    {
+        // Smallest face extent, relative to its coordinates, classified in float
+        constexpr double kMinFloatExtent = 1.0 / 4096.0;
+
+        // Relative error bounds of the float edge functions (a few float
+        // roundings) and of the double ones they must agree with
+        constexpr double kFloatError = 1.0 / (1 << 20);
+        constexpr double kDoubleError = 1.0 / (std::uint64_t(1) << 48);
+
+        // Twice the signed area of a projected polygon
+        double signedArea2(const double *u, const double *v, int count)
+        {
+            double area = 0.0;
+            for (int k = 0; k < count; ++k)
+            {
+                int next = (k + 1) % count;
+                area += u[k] * v[next] - u[next] * v[k];
+            }
+            return area;
+        }
+    }
+
+    FaceInsideTester::FaceInsideTester(const CzmFace &face)
+    {
+        int count = face.getNumVertices();
+        if (count < 3)
+            return;
+
+        // Newell normal, robust for collinear leading vertices
+        Vec3D normal(0, 0, 0);
+        for (int k = 0; k < count; ++k)
+        {
+            const Vec3D &a = face.getVertex(k);
+            const Vec3D &b = face.getVertex((k + 1) % count);
+            normal.comp[0] += (a.comp[1] - b.comp[1]) * (a.comp[2] + b.comp[2]);
+            normal.comp[1] += (a.comp[2] - b.comp[2]) * (a.comp[0] + b.comp[0]);
+            normal.comp[2] += (a.comp[0] - b.comp[0]) * (a.comp[1] + b.comp[1]);
+        }
+
+        // Project along the dominant normal axis
+        axis_ = 2;
+        if (std::fabs(normal.comp[0]) > std::fabs(normal.comp[axis_]))
+            axis_ = 0;
+        if (std::fabs(normal.comp[1]) > std::fabs(normal.comp[axis_]))
+            axis_ = 1;
+        u_ = (axis_ + 1) % 3;
+        v_ = (axis_ + 2) % 3;
+
+        double u[CzmFace::kMaxVertices], v[CzmFace::kMaxVertices];
+        for (int k = 0; k < count; ++k)
+        {
+            u[k] = face.getVertex(k).comp[u_];
+            v[k] = face.getVertex(k).comp[v_];
+        }
+
+        double area = signedArea2(u, v, count);
+        if (area == 0.0)
+            return;
+
+        // The float path works relative to the first vertex and needs the face
+        // extent to be well above float resolution at its coordinates
+        originU_ = static_cast<float>(u[0]);
+        originV_ = static_cast<float>(v[0]);
+        double extent = 0.0, magnitude = 0.0;
+        for (int k = 0; k < count; ++k)
+        {
+            extent = std::max({extent, std::fabs(u[k] - u[0]), std::fabs(v[k] - v[0])});
+            magnitude = std::max({magnitude, std::fabs(u[k]), std::fabs(v[k])});
+        }
+        floatSafe_ = extent > kMinFloatExtent * magnitude;
+
+        // Find a reflex quad vertex (turning against the polygon orientation)
+        int reflex = -1;
+        if (count == 4)
+        {
+            for (int k = 0; k < 4; ++k)
+            {
+                int prev = (k + 3) % 4, next = (k + 1) % 4;
+                double turn = (u[k] - u[prev]) * (v[next] - v[k]) - (v[k] - v[prev]) * (u[next] - u[k]);
+                if (turn * area < 0.0)
+                {
+                    reflex = k;
+                    break;
+                }
+            }
+        }
+
+        if (reflex < 0)
+        {
+            addPiece(u, v, count);
+            return;
+        }
+
+        // The diagonal from a reflex vertex lies inside the quad
+        for (int piece = 0; piece < 2; ++piece)
+        {
+            int corner[3] = {reflex, (reflex + 1 + piece) % 4, (reflex + 2 + piece) % 4};
+            double pu[3], pv[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                pu[k] = u[corner[k]];
+                pv[k] = v[corner[k]];
+            }
+            addPiece(pu, pv, 3);
+        }
+    }
+
+    void FaceInsideTester::addPiece(const double *u, const double *v, int count)
+    {
+        double area = signedArea2(u, v, count);
+        if (area == 0.0)
+            return;
+
+        double orientation = (area > 0.0) ? 1.0 : -1.0;
+        int piece = numPieces_++;
+        for (int k = 0; k < kEdgesPerPiece; ++k)
+        {
+            if (k >= count)
+            {
+                // Padding edge, always satisfied
+                a_[piece][k] = 0.0;
+                b_[piece][k] = 0.0;
+                c_[piece][k] = 1.0;
+                continue;
+            }
+
+            int next = (k + 1) % count;
+            double du = u[next] - u[k];
+            double dv = v[next] - v[k];
+            a_[piece][k] = -orientation * dv;
+            b_[piece][k] = orientation * du;
+            c_[piece][k] = orientation * (dv * u[k] - du * v[k]);
+        }
+    }
+
+    bool FaceInsideTester::containsProjected(double u, double v) const
+    {
+        bool inside = false;
+        for (int piece = 0; piece < numPieces_; ++piece)
+        {
+            bool inPiece = true;
+            for (int k = 0; k < kEdgesPerPiece; ++k)
+            {
+                inPiece &= (a_[piece][k] * u + b_[piece][k] * v + c_[piece][k] >= 0.0);
+            }
+            inside |= inPiece;
+        }
+        return inside;
+    }
+
+    bool FaceInsideTester::contains(const Vec3D &point) const
+    {
+        return containsProjected(point.comp[u_], point.comp[v_]);
+    }
+
+    namespace
+    {
+        // Coefficients of the tester shared with the kernels
+        struct EdgeFunctions
+        {
+            const double (*a)[FaceInsideTester::kEdgesPerPiece];
+            const double (*b)[FaceInsideTester::kEdgesPerPiece];
+            const double (*c)[FaceInsideTester::kEdgesPerPiece];
+            int numPieces;
+            int u, v;
+        };
+
+        // Scalar kernel over the points [begin, end); begin is a multiple of 64
+        // or continues the word of a vector kernel
+        void classifyScalar(const EdgeFunctions &f, const Vec3D *points, std::size_t begin, std::size_t end,
+                            std::uint64_t *mask)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                double u = points[i].comp[f.u];
+                double v = points[i].comp[f.v];
+                bool inside = false;
+                for (int piece = 0; piece < f.numPieces; ++piece)
+                {
+                    bool inPiece = true;
+                    for (int k = 0; k < FaceInsideTester::kEdgesPerPiece; ++k)
+                    {
+                        inPiece &= (f.a[piece][k] * u + f.b[piece][k] * v + f.c[piece][k] >= 0.0);
+                    }
+                    inside |= inPiece;
+                }
+                mask[i / 64] |= std::uint64_t(inside) << (i % 64);
+            }
+        }
+
+#ifdef CZM_FACE_X86_KERNELS
+        // AVX2 kernel: 4 points per iteration, coordinates gathered from the
+        // packed Vec3D array
+
+        __attribute__((target("avx2"))) void classifyAvx2(const EdgeFunctions &f, const Vec3D *points,
+                                                          std::size_t count, std::uint64_t *mask)
+        {
+            const double *base = points[0].comp;
+            const __m256i stride = _mm256_setr_epi64x(0, 3, 6, 9);
+            const __m256d zero = _mm256_setzero_pd();
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const double *block = base + 3 * i;
+                __m256d u = _mm256_i64gather_pd(block + f.u, stride, 8);
+                __m256d v = _mm256_i64gather_pd(block + f.v, stride, 8);
+
+                __m256d inside = zero;
+                for (int piece = 0; piece < f.numPieces; ++piece)
+                {
+                    __m256d inPiece = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+                    for (int k = 0; k < FaceInsideTester::kEdgesPerPiece; ++k)
+                    {
+                        __m256d value = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(f.a[piece][k]), u),
+                                                                    _mm256_mul_pd(_mm256_set1_pd(f.b[piece][k]), v)),
+                                                      _mm256_set1_pd(f.c[piece][k]));
+                        inPiece = _mm256_and_pd(inPiece, _mm256_cmp_pd(value, zero, _CMP_GE_OQ));
+                    }
+                    inside = _mm256_or_pd(inside, inPiece);
+                }
+
+                std::uint64_t bits = static_cast<std::uint64_t>(_mm256_movemask_pd(inside));
+                mask[i / 64] |= bits << (i % 64);
+            }
+            // GCC omits vzeroupper before the tail call, which then slows the
+            // SSE code after it
+            _mm256_zeroupper();
+            classifyScalar(f, points, i, count, mask);
+        }
+
+        // AVX-512 kernel: 8 points per iteration, same layout as the AVX2 one
+
+        __attribute__((target("avx512f"))) void classifyAvx512(const EdgeFunctions &f, const Vec3D *points,
+                                                               std::size_t count, std::uint64_t *mask)
+        {
+            const double *base = points[0].comp;
+            const __m512i stride = _mm512_setr_epi64(0, 3, 6, 9, 12, 15, 18, 21);
+            const __m512d zero = _mm512_setzero_pd();
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const double *block = base + 3 * i;
+                // Masked gathers with a zero source, as in the face kernels
+                __m512d u = _mm512_mask_i64gather_pd(zero, 0xFF, stride, block + f.u, 8);
+                __m512d v = _mm512_mask_i64gather_pd(zero, 0xFF, stride, block + f.v, 8);
+
+                __mmask8 inside = 0;
+                for (int piece = 0; piece < f.numPieces; ++piece)
+                {
+                    __mmask8 inPiece = 0xFF;
+                    for (int k = 0; k < FaceInsideTester::kEdgesPerPiece; ++k)
+                    {
+                        // No FMA, so boundary points classify as in the scalar kernel
+                        __m512d value = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_set1_pd(f.a[piece][k]), u),
+                                                                    _mm512_mul_pd(_mm512_set1_pd(f.b[piece][k]), v)),
+                                                      _mm512_set1_pd(f.c[piece][k]));
+                        inPiece = _mm512_mask_cmp_pd_mask(inPiece, value, zero, _CMP_GE_OQ);
+                    }
+                    inside = static_cast<__mmask8>(inside | inPiece);
+                }
+
+                mask[i / 64] |= static_cast<std::uint64_t>(inside) << (i % 64);
+            }
+            _mm256_zeroupper();
+            classifyScalar(f, points, i, count, mask);
+        }
+#endif
+    }
+
+    std::size_t FaceInsideTester::classify(Span<const Vec3D> points, Span<std::uint64_t> mask) const
+    {
+        std::size_t numWords = (points.size() + 63) / 64;
+        std::fill(mask.begin(), mask.begin() + std::min(numWords, mask.size()), std::uint64_t(0));
+        if (points.empty() || mask.size() < numWords)
+            return 0;
+
+        EdgeFunctions f{a_, b_, c_, numPieces_, u_, v_};
+#ifdef CZM_FACE_X86_KERNELS
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX512:
+            classifyAvx512(f, points.data(), points.size(), mask.data());
+            break;
+        case SimdLevel::AVX2:
+            classifyAvx2(f, points.data(), points.size(), mask.data());
+            break;
+        case SimdLevel::SCALAR:
+        default:
+            classifyScalar(f, points.data(), 0, points.size(), mask.data());
+            break;
+        }
+#else
+        classifyScalar(f, points.data(), 0, points.size(), mask.data());
+#endif
+
+        std::size_t inside = 0;
+        for (std::size_t w = 0; w < numWords; ++w)
+        {
+            inside += std::bitset<64>(mask[w]).count();
+        }
+        return inside;
+    }
+
+    namespace
+    {
+        // Float edge functions a du + b dv + c relative to the origin, with
+        // the error bound ea |du| + eb |dv| + ec of each
+        struct FloatEdgeFunctions
+        {
+            float a[FaceInsideTester::kMaxPieces][FaceInsideTester::kEdgesPerPiece];
+            float b[FaceInsideTester::kMaxPieces][FaceInsideTester::kEdgesPerPiece];
+            float c[FaceInsideTester::kMaxPieces][FaceInsideTester::kEdgesPerPiece];
+            float ea[FaceInsideTester::kMaxPieces][FaceInsideTester::kEdgesPerPiece];
+            float eb[FaceInsideTester::kMaxPieces][FaceInsideTester::kEdgesPerPiece];
+            float ec[FaceInsideTester::kMaxPieces][FaceInsideTester::kEdgesPerPiece];
+            float originU, originV;
+            int numPieces;
+            int u, v;
+        };
+
+        // Scalar float kernel over [begin, end); sets the bits of points inside
+        // in mask and of points too close to an edge to trust in ambiguous
+        void classifyFloatScalar(const FloatEdgeFunctions &f, const Vec3f *points, std::size_t begin,
+                                 std::size_t end, std::uint64_t *mask, std::uint64_t *ambiguous)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                float du = points[i].comp[f.u] - f.originU;
+                float dv = points[i].comp[f.v] - f.originV;
+                bool inside = false, unsure = false;
+                for (int piece = 0; piece < f.numPieces; ++piece)
+                {
+                    bool inPiece = true;
+                    for (int k = 0; k < FaceInsideTester::kEdgesPerPiece; ++k)
+                    {
+                        float value = f.a[piece][k] * du + f.b[piece][k] * dv + f.c[piece][k];
+                        float error = f.ea[piece][k] * std::fabs(du) + f.eb[piece][k] * std::fabs(dv) + f.ec[piece][k];
+                        inPiece &= (value >= 0.0f);
+                        unsure |= (std::fabs(value) <= error);
+                    }
+                    inside |= inPiece;
+                }
+                mask[i / 64] |= std::uint64_t(inside) << (i % 64);
+                ambiguous[i / 64] |= std::uint64_t(unsure) << (i % 64);
+            }
+        }
+
+#ifdef CZM_FACE_X86_KERNELS
+        // AVX2 float kernel: 8 points per iteration
+
+        __attribute__((target("avx2"))) void classifyFloatAvx2(const FloatEdgeFunctions &f, const Vec3f *points,
+                                                               std::size_t count, std::uint64_t *mask,
+                                                               std::uint64_t *ambiguous)
+        {
+            const float *base = points[0].comp;
+            const __m256i stride = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+            const __m256 originU = _mm256_set1_ps(f.originU);
+            const __m256 originV = _mm256_set1_ps(f.originV);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const float *block = base + 3 * i;
+                __m256 du = _mm256_sub_ps(_mm256_i32gather_ps(block + f.u, stride, 4), originU);
+                __m256 dv = _mm256_sub_ps(_mm256_i32gather_ps(block + f.v, stride, 4), originV);
+                __m256 absU = _mm256_and_ps(du, absMask);
+                __m256 absV = _mm256_and_ps(dv, absMask);
+
+                __m256 inside = zero, unsure = zero;
+                for (int piece = 0; piece < f.numPieces; ++piece)
+                {
+                    __m256 inPiece = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                    for (int k = 0; k < FaceInsideTester::kEdgesPerPiece; ++k)
+                    {
+                        // No FMA, so values round as in the scalar kernel
+                        __m256 value = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(f.a[piece][k]), du),
+                                                                   _mm256_mul_ps(_mm256_set1_ps(f.b[piece][k]), dv)),
+                                                     _mm256_set1_ps(f.c[piece][k]));
+                        __m256 error = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(f.ea[piece][k]), absU),
+                                                                   _mm256_mul_ps(_mm256_set1_ps(f.eb[piece][k]), absV)),
+                                                     _mm256_set1_ps(f.ec[piece][k]));
+                        inPiece = _mm256_and_ps(inPiece, _mm256_cmp_ps(value, zero, _CMP_GE_OQ));
+                        unsure = _mm256_or_ps(unsure, _mm256_cmp_ps(_mm256_and_ps(value, absMask), error, _CMP_LE_OQ));
+                    }
+                    inside = _mm256_or_ps(inside, inPiece);
+                }
+
+                mask[i / 64] |= static_cast<std::uint64_t>(_mm256_movemask_ps(inside)) << (i % 64);
+                ambiguous[i / 64] |= static_cast<std::uint64_t>(_mm256_movemask_ps(unsure)) << (i % 64);
+            }
+            // GCC omits vzeroupper before the tail call, which then slows the
+            // SSE code after every block
+            _mm256_zeroupper();
+            classifyFloatScalar(f, points, i, count, mask, ambiguous);
+        }
+
+        // AVX-512 float kernel: 16 points per iteration
+
+        __attribute__((target("avx512f"))) void classifyFloatAvx512(const FloatEdgeFunctions &f, const Vec3f *points,
+                                                                    std::size_t count, std::uint64_t *mask,
+                                                                    std::uint64_t *ambiguous)
+        {
+            const float *base = points[0].comp;
+            const __m512i stride = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36, 39, 42, 45);
+            const __m512 zero = _mm512_setzero_ps();
+            const __m512 originU = _mm512_set1_ps(f.originU);
+            const __m512 originV = _mm512_set1_ps(f.originV);
+
+            std::size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const float *block = base + 3 * i;
+                __m512 du = _mm512_sub_ps(_mm512_mask_i32gather_ps(zero, 0xFFFF, stride, block + f.u, 4), originU);
+                __m512 dv = _mm512_sub_ps(_mm512_mask_i32gather_ps(zero, 0xFFFF, stride, block + f.v, 4), originV);
+                __m512 absU = _mm512_abs_ps(du);
+                __m512 absV = _mm512_abs_ps(dv);
+
+                __mmask16 inside = 0, unsure = 0;
+                for (int piece = 0; piece < f.numPieces; ++piece)
+                {
+                    __mmask16 inPiece = 0xFFFF;
+                    for (int k = 0; k < FaceInsideTester::kEdgesPerPiece; ++k)
+                    {
+                        __m512 value = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(f.a[piece][k]), du),
+                                                                   _mm512_mul_ps(_mm512_set1_ps(f.b[piece][k]), dv)),
+                                                     _mm512_set1_ps(f.c[piece][k]));
+                        __m512 error = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(f.ea[piece][k]), absU),
+                                                                   _mm512_mul_ps(_mm512_set1_ps(f.eb[piece][k]), absV)),
+                                                     _mm512_set1_ps(f.ec[piece][k]));
+                        inPiece = _mm512_mask_cmp_ps_mask(inPiece, value, zero, _CMP_GE_OQ);
+                        unsure = static_cast<__mmask16>(unsure | _mm512_cmp_ps_mask(_mm512_abs_ps(value), error, _CMP_LE_OQ));
+                    }
+                    inside = static_cast<__mmask16>(inside | inPiece);
+                }
+
+                mask[i / 64] |= static_cast<std::uint64_t>(inside) << (i % 64);
+                ambiguous[i / 64] |= static_cast<std::uint64_t>(unsure) << (i % 64);
+            }
+            // GCC omits vzeroupper before the tail call, which then slows the
+            // SSE code after every block
+            _mm256_zeroupper();
+            classifyFloatScalar(f, points, i, count, mask, ambiguous);
+        }
+#endif
+
+        // Classify a block of at most 64 points with the best kernel
+        void classifyFloatBlock(const FloatEdgeFunctions &f, const Vec3f *points, std::size_t count,
+                                std::uint64_t *mask, std::uint64_t *ambiguous)
+        {
+#ifdef CZM_FACE_X86_KERNELS
+            switch (getSimdLevel())
+            {
+            case SimdLevel::AVX512:
+                return classifyFloatAvx512(f, points, count, mask, ambiguous);
+            case SimdLevel::AVX2:
+                return classifyFloatAvx2(f, points, count, mask, ambiguous);
+            case SimdLevel::SCALAR:
+            default:
+                return classifyFloatScalar(f, points, 0, count, mask, ambiguous);
+            }
+#else
+            classifyFloatScalar(f, points, 0, count, mask, ambiguous);
+#endif
+        }
+    }
+
+    std::size_t FaceInsideTester::classify(Span<const Vec3f> points, Span<std::uint64_t> mask) const
+    {
+        std::size_t numWords = (points.size() + 63) / 64;
+        std::fill(mask.begin(), mask.begin() + std::min(numWords, mask.size()), std::uint64_t(0));
+        if (points.empty() || mask.size() < numWords)
+            return 0;
+
+        // Shift the edge functions to the origin and bound the error of
+        // evaluating them in float against the double evaluation
+        FloatEdgeFunctions f;
+        if (floatSafe_)
+        {
+            f.originU = static_cast<float>(originU_);
+            f.originV = static_cast<float>(originV_);
+            f.numPieces = numPieces_;
+            f.u = u_;
+            f.v = v_;
+            for (int piece = 0; piece < kMaxPieces; ++piece)
+            {
+                for (int k = 0; k < kEdgesPerPiece; ++k)
+                {
+                    double a = a_[piece][k], b = b_[piece][k];
+                    double c = a * originU_ + b * originV_ + c_[piece][k];
+                    double roundoff = std::fabs(a * originU_) + std::fabs(b * originV_) + std::fabs(c_[piece][k]);
+                    f.a[piece][k] = static_cast<float>(a);
+                    f.b[piece][k] = static_cast<float>(b);
+                    f.c[piece][k] = static_cast<float>(c);
+                    f.ea[piece][k] = static_cast<float>(std::fabs(a) * (kFloatError + kDoubleError));
+                    f.eb[piece][k] = static_cast<float>(std::fabs(b) * (kFloatError + kDoubleError));
+                    f.ec[piece][k] = static_cast<float>(std::fabs(c) * kFloatError + roundoff * kDoubleError);
+                }
+            }
+        }
+
+        // Blocks of 64 points, one mask word each, so the ambiguous points
+        // are tracked in a single word and recomputed in double right away
+        std::size_t inside = 0;
+        for (std::size_t w = 0; w < numWords; ++w)
+        {
+            std::size_t first = w * 64;
+            std::size_t count = std::min<std::size_t>(64, points.size() - first);
+
+            // Every point is ambiguous when the face is too small for float
+            std::uint64_t ambiguous = floatSafe_ ? 0 : ~std::uint64_t(0);
+            if (floatSafe_)
+                classifyFloatBlock(f, points.data() + first, count, &mask[w], &ambiguous);
+            if (count < 64)
+                ambiguous &= (std::uint64_t(1) << count) - 1;
+
+            for (int bit = 0; ambiguous != 0; ++bit, ambiguous >>= 1)
+            {
+                if (!(ambiguous & 1))
+                    continue;
+
+                const Vec3f &point = points[first + bit];
+                std::uint64_t flag = std::uint64_t(1) << bit;
+                if (containsProjected(point.comp[u_], point.comp[v_]))
+                    mask[w] |= flag;
+                else
+                    mask[w] &= ~flag;
+            }
+            inside += std::bitset<64>(mask[w]).count();
+        }
+        return inside;
+    }
+
+} // namespace czm_face
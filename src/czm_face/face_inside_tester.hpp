@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "vec3d/vec3d.h"
+#include "czm_face.hpp"
+#include "span.hpp"
+
+namespace czm_face
+{
+
+    // Point-in-face test prepared once per face. Points are projected along
+    // the dominant axis of the face normal, so faces in any orientation are
+    // handled, and the face is stored as up to two convex pieces of four edge
+    // functions a u + b v + c (non-negative inside). Convex faces use one
+    // piece; a non-convex quad is split along the diagonal at its reflex
+    // vertex. Points on the boundary count as inside.
+    class FaceInsideTester
+    {
+    public:
+        static constexpr int kMaxPieces = 2;
+        static constexpr int kEdgesPerPiece = 4;
+
+        // Empty tester; classifies every point as outside
+        FaceInsideTester() = default;
+        explicit FaceInsideTester(const CzmFace &face);
+        ~FaceInsideTester() = default;
+
+        // Allow copying
+        FaceInsideTester(const FaceInsideTester &) = default;
+        FaceInsideTester &operator=(const FaceInsideTester &) = default;
+
+        // Allow moving
+        FaceInsideTester(FaceInsideTester &&) = default;
+        FaceInsideTester &operator=(FaceInsideTester &&) = default;
+
+        // Get the coordinate axis points are projected along
+        int getAxis() const { return axis_; }
+
+        // Check if a single point is inside the face
+        bool contains(const Vec3D &point) const;
+
+        // Classify many points. Bit (i % 64) of mask[i / 64] is set if
+        // points[i] is inside; mask needs (points.size() + 63) / 64 words and
+        // is overwritten. Returns the number of points inside.
+        std::size_t classify(Span<const Vec3D> points, Span<std::uint64_t> mask) const;
+
+        // Classify single precision points with the same mask contract, at
+        // twice the SIMD width. Edge functions are evaluated in float relative
+        // to a face vertex; points whose value is within the rounding error
+        // bound of an edge are recomputed in double, so the result equals
+        // classify() of the points converted to double. Faces too small for
+        // float to resolve are classified in double throughout.
+        std::size_t classify(Span<const Vec3f> points, Span<std::uint64_t> mask) const;
+
+    private:
+        // Add a convex piece from projected polygon corners
+        void addPiece(const double *u, const double *v, int count);
+
+        // Evaluate the pieces for projected coordinates
+        bool containsProjected(double u, double v) const;
+
+        double a_[kMaxPieces][kEdgesPerPiece] = {}; // Edge function u coefficients
+        double b_[kMaxPieces][kEdgesPerPiece] = {}; // Edge function v coefficients
+        double c_[kMaxPieces][kEdgesPerPiece] = {}; // Edge function constants
+        int numPieces_ = 0;                         // Number of convex pieces
+        int axis_ = 2;                              // Projection axis
+        int u_ = 0;                                 // First in-plane axis
+        int v_ = 1;                                 // Second in-plane axis
+        double originU_ = 0.0;                      // Float path origin, exact in float
+        double originV_ = 0.0;
+        bool floatSafe_ = false;                    // Face resolvable in float
+    };
+
+} // namespace czm_face
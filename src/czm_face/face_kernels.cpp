@@ -0,0 +1,364 @@
+#include "face_kernels.hpp"
+#include "simd_dispatch.hpp"
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CZM_FACE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace czm_face
+{
+
+    namespace
+    {
+        // Scalar kernels over the face range [begin, end)
+
+        void areasScalar(const FaceGeometryView &f, std::size_t begin, std::size_t end, double *areas)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t v0 = f.offsets[i];
+                std::size_t v3 = f.offsets[i + 1] - 1;
+
+                double e1x = f.x[v0 + 1] - f.x[v0], e1y = f.y[v0 + 1] - f.y[v0], e1z = f.z[v0 + 1] - f.z[v0];
+                double e2x = f.x[v0 + 2] - f.x[v0], e2y = f.y[v0 + 2] - f.y[v0], e2z = f.z[v0 + 2] - f.z[v0];
+                double e3x = f.x[v3] - f.x[v0], e3y = f.y[v3] - f.y[v0], e3z = f.z[v3] - f.z[v0];
+
+                // For triangles v3 == v2, so the second cross product vanishes
+                double c1x = e1y * e2z - e1z * e2y;
+                double c1y = e1z * e2x - e1x * e2z;
+                double c1z = e1x * e2y - e1y * e2x;
+                double c2x = e2y * e3z - e2z * e3y;
+                double c2y = e2z * e3x - e2x * e3z;
+                double c2z = e2x * e3y - e2y * e3x;
+
+                areas[i] = 0.5 * (std::sqrt(c1x * c1x + c1y * c1y + c1z * c1z) +
+                                  std::sqrt(c2x * c2x + c2y * c2y + c2z * c2z));
+            }
+        }
+
+        void normalsScalar(const FaceGeometryView &f, std::size_t begin, std::size_t end,
+                           double *nx, double *ny, double *nz)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t v0 = f.offsets[i];
+
+                double e1x = f.x[v0 + 1] - f.x[v0], e1y = f.y[v0 + 1] - f.y[v0], e1z = f.z[v0 + 1] - f.z[v0];
+                double e2x = f.x[v0 + 2] - f.x[v0], e2y = f.y[v0 + 2] - f.y[v0], e2z = f.z[v0 + 2] - f.z[v0];
+
+                double cx = e1y * e2z - e1z * e2y;
+                double cy = e1z * e2x - e1x * e2z;
+                double cz = e1x * e2y - e1y * e2x;
+
+                double magnitude = std::sqrt(cx * cx + cy * cy + cz * cz);
+                if (magnitude > 0)
+                {
+                    cx /= magnitude;
+                    cy /= magnitude;
+                    cz /= magnitude;
+                }
+                nx[i] = cx;
+                ny[i] = cy;
+                nz[i] = cz;
+            }
+        }
+
+        void centersScalar(const FaceGeometryView &f, std::size_t begin, std::size_t end,
+                           double *cx, double *cy, double *cz)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                std::size_t first = f.offsets[i];
+                std::size_t last = f.offsets[i + 1];
+                double sx = 0.0, sy = 0.0, sz = 0.0;
+                for (std::size_t k = first; k < last; ++k)
+                {
+                    sx += f.x[k];
+                    sy += f.y[k];
+                    sz += f.z[k];
+                }
+                double count = static_cast<double>(last - first);
+                cx[i] = sx / count;
+                cy[i] = sy / count;
+                cz[i] = sz / count;
+            }
+        }
+
+#ifdef CZM_FACE_X86_KERNELS
+        static_assert(sizeof(std::size_t) == sizeof(long long), "64-bit offsets required for gathers");
+
+        // AVX2 kernels: 4 faces per iteration. Vertex 3 is gathered from the
+        // last vertex of each face, which repeats vertex 2 for triangles.
+
+        __attribute__((target("avx2"))) inline void gatherFaces4(const FaceGeometryView &f, std::size_t i,
+                                                                 __m256d (&vx)[4], __m256d (&vy)[4], __m256d (&vz)[4],
+                                                                 __m256d &isQuad)
+        {
+            __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(f.offsets + i));
+            __m256i next = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(f.offsets + i + 1));
+            __m256i one = _mm256_set1_epi64x(1);
+
+            __m256i index[4];
+            index[0] = first;
+            index[1] = _mm256_add_epi64(first, one);
+            index[2] = _mm256_add_epi64(index[1], one);
+            index[3] = _mm256_sub_epi64(next, one);
+
+            for (int k = 0; k < 4; ++k)
+            {
+                vx[k] = _mm256_i64gather_pd(f.x, index[k], 8);
+                vy[k] = _mm256_i64gather_pd(f.y, index[k], 8);
+                vz[k] = _mm256_i64gather_pd(f.z, index[k], 8);
+            }
+
+            __m256i count = _mm256_sub_epi64(next, first);
+            isQuad = _mm256_castsi256_pd(_mm256_cmpeq_epi64(count, _mm256_set1_epi64x(4)));
+        }
+
+        __attribute__((target("avx2"))) inline __m256d crossNorm4(__m256d ax, __m256d ay, __m256d az,
+                                                                  __m256d bx, __m256d by, __m256d bz,
+                                                                  __m256d &cx, __m256d &cy, __m256d &cz)
+        {
+            cx = _mm256_sub_pd(_mm256_mul_pd(ay, bz), _mm256_mul_pd(az, by));
+            cy = _mm256_sub_pd(_mm256_mul_pd(az, bx), _mm256_mul_pd(ax, bz));
+            cz = _mm256_sub_pd(_mm256_mul_pd(ax, by), _mm256_mul_pd(ay, bx));
+            __m256d sq = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(cx, cx), _mm256_mul_pd(cy, cy)),
+                                       _mm256_mul_pd(cz, cz));
+            return _mm256_sqrt_pd(sq);
+        }
+
+        __attribute__((target("avx2"))) void areasAvx2(const FaceGeometryView &f, double *areas)
+        {
+            std::size_t i = 0;
+            const __m256d half = _mm256_set1_pd(0.5);
+            for (; i + 4 <= f.numFaces; i += 4)
+            {
+                __m256d vx[4], vy[4], vz[4], isQuad;
+                gatherFaces4(f, i, vx, vy, vz, isQuad);
+
+                __m256d e1x = _mm256_sub_pd(vx[1], vx[0]), e1y = _mm256_sub_pd(vy[1], vy[0]), e1z = _mm256_sub_pd(vz[1], vz[0]);
+                __m256d e2x = _mm256_sub_pd(vx[2], vx[0]), e2y = _mm256_sub_pd(vy[2], vy[0]), e2z = _mm256_sub_pd(vz[2], vz[0]);
+                __m256d e3x = _mm256_sub_pd(vx[3], vx[0]), e3y = _mm256_sub_pd(vy[3], vy[0]), e3z = _mm256_sub_pd(vz[3], vz[0]);
+
+                __m256d cx, cy, cz;
+                __m256d m1 = crossNorm4(e1x, e1y, e1z, e2x, e2y, e2z, cx, cy, cz);
+                __m256d m2 = crossNorm4(e2x, e2y, e2z, e3x, e3y, e3z, cx, cy, cz);
+                _mm256_storeu_pd(areas + i, _mm256_mul_pd(half, _mm256_add_pd(m1, m2)));
+            }
+            areasScalar(f, i, f.numFaces, areas);
+        }
+
+        __attribute__((target("avx2"))) void normalsAvx2(const FaceGeometryView &f, double *nx, double *ny, double *nz)
+        {
+            std::size_t i = 0;
+            const __m256d zero = _mm256_setzero_pd();
+            for (; i + 4 <= f.numFaces; i += 4)
+            {
+                __m256d vx[4], vy[4], vz[4], isQuad;
+                gatherFaces4(f, i, vx, vy, vz, isQuad);
+
+                __m256d e1x = _mm256_sub_pd(vx[1], vx[0]), e1y = _mm256_sub_pd(vy[1], vy[0]), e1z = _mm256_sub_pd(vz[1], vz[0]);
+                __m256d e2x = _mm256_sub_pd(vx[2], vx[0]), e2y = _mm256_sub_pd(vy[2], vy[0]), e2z = _mm256_sub_pd(vz[2], vz[0]);
+
+                __m256d cx, cy, cz;
+                __m256d magnitude = crossNorm4(e1x, e1y, e1z, e2x, e2y, e2z, cx, cy, cz);
+
+                // Degenerate faces keep their (zero) cross product
+                __m256d valid = _mm256_cmp_pd(magnitude, zero, _CMP_GT_OQ);
+                _mm256_storeu_pd(nx + i, _mm256_blendv_pd(cx, _mm256_div_pd(cx, magnitude), valid));
+                _mm256_storeu_pd(ny + i, _mm256_blendv_pd(cy, _mm256_div_pd(cy, magnitude), valid));
+                _mm256_storeu_pd(nz + i, _mm256_blendv_pd(cz, _mm256_div_pd(cz, magnitude), valid));
+            }
+            normalsScalar(f, i, f.numFaces, nx, ny, nz);
+        }
+
+        __attribute__((target("avx2"))) void centersAvx2(const FaceGeometryView &f, double *cx, double *cy, double *cz)
+        {
+            std::size_t i = 0;
+            const __m256d three = _mm256_set1_pd(3.0);
+            const __m256d four = _mm256_set1_pd(4.0);
+            for (; i + 4 <= f.numFaces; i += 4)
+            {
+                __m256d vx[4], vy[4], vz[4], isQuad;
+                gatherFaces4(f, i, vx, vy, vz, isQuad);
+
+                __m256d count = _mm256_blendv_pd(three, four, isQuad);
+                __m256d sx = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(vx[0], vx[1]), vx[2]), _mm256_and_pd(vx[3], isQuad));
+                __m256d sy = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(vy[0], vy[1]), vy[2]), _mm256_and_pd(vy[3], isQuad));
+                __m256d sz = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(vz[0], vz[1]), vz[2]), _mm256_and_pd(vz[3], isQuad));
+                _mm256_storeu_pd(cx + i, _mm256_div_pd(sx, count));
+                _mm256_storeu_pd(cy + i, _mm256_div_pd(sy, count));
+                _mm256_storeu_pd(cz + i, _mm256_div_pd(sz, count));
+            }
+            centersScalar(f, i, f.numFaces, cx, cy, cz);
+        }
+
+        // AVX-512 kernels: 8 faces per iteration, same layout as the AVX2 ones
+
+        __attribute__((target("avx512f"))) inline void gatherFaces8(const FaceGeometryView &f, std::size_t i,
+                                                                    __m512d (&vx)[4], __m512d (&vy)[4], __m512d (&vz)[4],
+                                                                    __mmask8 &isQuad)
+        {
+            __m512i first = _mm512_loadu_si512(f.offsets + i);
+            __m512i next = _mm512_loadu_si512(f.offsets + i + 1);
+            __m512i one = _mm512_set1_epi64(1);
+
+            __m512i index[4];
+            index[0] = first;
+            index[1] = _mm512_add_epi64(first, one);
+            index[2] = _mm512_add_epi64(index[1], one);
+            index[3] = _mm512_sub_epi64(next, one);
+
+            // Masked gathers with a zero source; the unmasked forms start from
+            // an undefined register that GCC reports as maybe uninitialized
+            const __m512d zero = _mm512_setzero_pd();
+            for (int k = 0; k < 4; ++k)
+            {
+                vx[k] = _mm512_mask_i64gather_pd(zero, 0xFF, index[k], f.x, 8);
+                vy[k] = _mm512_mask_i64gather_pd(zero, 0xFF, index[k], f.y, 8);
+                vz[k] = _mm512_mask_i64gather_pd(zero, 0xFF, index[k], f.z, 8);
+            }
+
+            isQuad = _mm512_cmpeq_epi64_mask(_mm512_sub_epi64(next, first), _mm512_set1_epi64(4));
+        }
+
+        __attribute__((target("avx512f"))) inline __m512d crossNorm8(__m512d ax, __m512d ay, __m512d az,
+                                                                     __m512d bx, __m512d by, __m512d bz,
+                                                                     __m512d &cx, __m512d &cy, __m512d &cz)
+        {
+            cx = _mm512_sub_pd(_mm512_mul_pd(ay, bz), _mm512_mul_pd(az, by));
+            cy = _mm512_sub_pd(_mm512_mul_pd(az, bx), _mm512_mul_pd(ax, bz));
+            cz = _mm512_sub_pd(_mm512_mul_pd(ax, by), _mm512_mul_pd(ay, bx));
+            __m512d sq = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(cx, cx), _mm512_mul_pd(cy, cy)),
+                                       _mm512_mul_pd(cz, cz));
+            return _mm512_maskz_sqrt_pd(0xFF, sq);
+        }
+
+        __attribute__((target("avx512f"))) void areasAvx512(const FaceGeometryView &f, double *areas)
+        {
+            std::size_t i = 0;
+            const __m512d half = _mm512_set1_pd(0.5);
+            for (; i + 8 <= f.numFaces; i += 8)
+            {
+                __m512d vx[4], vy[4], vz[4];
+                __mmask8 isQuad;
+                gatherFaces8(f, i, vx, vy, vz, isQuad);
+
+                __m512d e1x = _mm512_sub_pd(vx[1], vx[0]), e1y = _mm512_sub_pd(vy[1], vy[0]), e1z = _mm512_sub_pd(vz[1], vz[0]);
+                __m512d e2x = _mm512_sub_pd(vx[2], vx[0]), e2y = _mm512_sub_pd(vy[2], vy[0]), e2z = _mm512_sub_pd(vz[2], vz[0]);
+                __m512d e3x = _mm512_sub_pd(vx[3], vx[0]), e3y = _mm512_sub_pd(vy[3], vy[0]), e3z = _mm512_sub_pd(vz[3], vz[0]);
+
+                __m512d cx, cy, cz;
+                __m512d m1 = crossNorm8(e1x, e1y, e1z, e2x, e2y, e2z, cx, cy, cz);
+                __m512d m2 = crossNorm8(e2x, e2y, e2z, e3x, e3y, e3z, cx, cy, cz);
+                _mm512_storeu_pd(areas + i, _mm512_mul_pd(half, _mm512_add_pd(m1, m2)));
+            }
+            areasScalar(f, i, f.numFaces, areas);
+        }
+
+        __attribute__((target("avx512f"))) void normalsAvx512(const FaceGeometryView &f, double *nx, double *ny, double *nz)
+        {
+            std::size_t i = 0;
+            const __m512d zero = _mm512_setzero_pd();
+            for (; i + 8 <= f.numFaces; i += 8)
+            {
+                __m512d vx[4], vy[4], vz[4];
+                __mmask8 isQuad;
+                gatherFaces8(f, i, vx, vy, vz, isQuad);
+
+                __m512d e1x = _mm512_sub_pd(vx[1], vx[0]), e1y = _mm512_sub_pd(vy[1], vy[0]), e1z = _mm512_sub_pd(vz[1], vz[0]);
+                __m512d e2x = _mm512_sub_pd(vx[2], vx[0]), e2y = _mm512_sub_pd(vy[2], vy[0]), e2z = _mm512_sub_pd(vz[2], vz[0]);
+
+                __m512d cx, cy, cz;
+                __m512d magnitude = crossNorm8(e1x, e1y, e1z, e2x, e2y, e2z, cx, cy, cz);
+
+                // Degenerate faces keep their (zero) cross product
+                __mmask8 valid = _mm512_cmp_pd_mask(magnitude, zero, _CMP_GT_OQ);
+                _mm512_storeu_pd(nx + i, _mm512_mask_div_pd(cx, valid, cx, magnitude));
+                _mm512_storeu_pd(ny + i, _mm512_mask_div_pd(cy, valid, cy, magnitude));
+                _mm512_storeu_pd(nz + i, _mm512_mask_div_pd(cz, valid, cz, magnitude));
+            }
+            normalsScalar(f, i, f.numFaces, nx, ny, nz);
+        }
+
+        __attribute__((target("avx512f"))) void centersAvx512(const FaceGeometryView &f, double *cx, double *cy, double *cz)
+        {
+            std::size_t i = 0;
+            const __m512d three = _mm512_set1_pd(3.0);
+            const __m512d four = _mm512_set1_pd(4.0);
+            for (; i + 8 <= f.numFaces; i += 8)
+            {
+                __m512d vx[4], vy[4], vz[4];
+                __mmask8 isQuad;
+                gatherFaces8(f, i, vx, vy, vz, isQuad);
+
+                __m512d count = _mm512_mask_blend_pd(isQuad, three, four);
+                __m512d sx = _mm512_add_pd(_mm512_add_pd(vx[0], vx[1]), vx[2]);
+                __m512d sy = _mm512_add_pd(_mm512_add_pd(vy[0], vy[1]), vy[2]);
+                __m512d sz = _mm512_add_pd(_mm512_add_pd(vz[0], vz[1]), vz[2]);
+                sx = _mm512_mask_add_pd(sx, isQuad, sx, vx[3]);
+                sy = _mm512_mask_add_pd(sy, isQuad, sy, vy[3]);
+                sz = _mm512_mask_add_pd(sz, isQuad, sz, vz[3]);
+                _mm512_storeu_pd(cx + i, _mm512_div_pd(sx, count));
+                _mm512_storeu_pd(cy + i, _mm512_div_pd(sy, count));
+                _mm512_storeu_pd(cz + i, _mm512_div_pd(sz, count));
+            }
+            centersScalar(f, i, f.numFaces, cx, cy, cz);
+        }
+#endif
+    }
+
+    void computeFaceAreas(const FaceGeometryView &faces, double *areas)
+    {
+#ifdef CZM_FACE_X86_KERNELS
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX512:
+            return areasAvx512(faces, areas);
+        case SimdLevel::AVX2:
+            return areasAvx2(faces, areas);
+        case SimdLevel::SCALAR:
+        default:
+            break;
+        }
+#endif
+        areasScalar(faces, 0, faces.numFaces, areas);
+    }
+
+    void computeFaceNormals(const FaceGeometryView &faces, double *nx, double *ny, double *nz)
+    {
+#ifdef CZM_FACE_X86_KERNELS
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX512:
+            return normalsAvx512(faces, nx, ny, nz);
+        case SimdLevel::AVX2:
+            return normalsAvx2(faces, nx, ny, nz);
+        case SimdLevel::SCALAR:
+        default:
+            break;
+        }
+#endif
+        normalsScalar(faces, 0, faces.numFaces, nx, ny, nz);
+    }
+
+    void computeFaceCenters(const FaceGeometryView &faces, double *cx, double *cy, double *cz)
+    {
+#ifdef CZM_FACE_X86_KERNELS
+        switch (getSimdLevel())
+        {
+        case SimdLevel::AVX512:
+            return centersAvx512(faces, cx, cy, cz);
+        case SimdLevel::AVX2:
+            return centersAvx2(faces, cx, cy, cz);
+        case SimdLevel::SCALAR:
+        default:
+            break;
+        }
+#endif
+        centersScalar(faces, 0, faces.numFaces, cx, cy, cz);
+    }
+
+} // namespace czm_face
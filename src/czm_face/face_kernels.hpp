@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+namespace czm_face
+{
+
+    // Read-only view of packed face coordinates: the vertices of face i are
+    // (x[k], y[k], z[k]) for k in [offsets[i], offsets[i + 1]). Every face
+    // must have 3 or 4 vertices.
+    struct FaceGeometryView
+    {
+        const double *x = nullptr;
+        const double *y = nullptr;
+        const double *z = nullptr;
+        const std::size_t *offsets = nullptr; // numFaces + 1 entries
+        std::size_t numFaces = 0;
+    };
+
+    // Batch geometry kernels. Each call processes every face of the view using
+    // the instruction set selected in simd_dispatch.hpp and writes one value
+    // (or one component triple) per face to the output arrays.
+
+    // Face areas (quads as the sum of triangles (v0, v1, v2) and (v0, v2, v3))
+    void computeFaceAreas(const FaceGeometryView &faces, double *areas);
+
+    // Unit face normals from the first three vertices (zero for degenerate faces)
+    void computeFaceNormals(const FaceGeometryView &faces, double *nx, double *ny, double *nz);
+
+    // Face centers (vertex averages)
+    void computeFaceCenters(const FaceGeometryView &faces, double *cx, double *cy, double *cz);
+
+} // namespace czm_face
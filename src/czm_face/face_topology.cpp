@@ -0,0 +1,202 @@
+#include "face_topology.hpp"
+#include "spatial_hash.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        // Key of an exact coordinate triple (-0.0 is folded into 0.0)
+        std::uint64_t exactKey(const Vec3D &v)
+        {
+            std::int64_t bits[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                double value = v.comp[k] + 0.0;
+                std::memcpy(&bits[k], &value, sizeof(double));
+            }
+            return hashCell(bits[0], bits[1], bits[2]);
+        }
+
+        // Merges vertices closer than a tolerance through a multimap from
+        // quantized cell keys to vertex ids
+        class VertexWelder
+        {
+        public:
+            VertexWelder(std::vector<Vec3D> &vertices, double tolerance, std::size_t expected)
+                : vertices_(vertices), tolerance_(tolerance), toleranceSquared_(tolerance * tolerance),
+                  inverseCell_(tolerance > 0.0 ? 1.0 / tolerance : 0.0)
+            {
+                ids_.reserve(expected);
+            }
+
+            // Get the id of a vertex, adding it if no vertex is close enough
+            std::uint32_t insert(const Vec3D &v)
+            {
+                if (tolerance_ <= 0.0)
+                {
+                    std::uint64_t key = exactKey(v);
+                    auto range = ids_.equal_range(key);
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        if (vertices_[it->second] == v)
+                            return it->second;
+                    }
+                    return add(key, v);
+                }
+
+                // Cells are one tolerance wide, so matches lie in the 27 neighbours
+                GridCell cell = quantizeToCell(v.comp[0], v.comp[1], v.comp[2], inverseCell_);
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    for (int dy = -1; dy <= 1; ++dy)
+                    {
+                        for (int dz = -1; dz <= 1; ++dz)
+                        {
+                            auto range = ids_.equal_range(hashCell(cell.x + dx, cell.y + dy, cell.z + dz));
+                            for (auto it = range.first; it != range.second; ++it)
+                            {
+                                if ((vertices_[it->second] - v).squaredLength() <= toleranceSquared_)
+                                    return it->second;
+                            }
+                        }
+                    }
+                }
+                return add(hashCell(cell.x, cell.y, cell.z), v);
+            }
+
+        private:
+            std::uint32_t add(std::uint64_t key, const Vec3D &v)
+            {
+                std::uint32_t id = static_cast<std::uint32_t>(vertices_.size());
+                vertices_.push_back(v);
+                ids_.emplace(key, id);
+                return id;
+            }
+
+            std::vector<Vec3D> &vertices_;
+            std::unordered_multimap<std::uint64_t, std::uint32_t> ids_;
+            double tolerance_;
+            double toleranceSquared_;
+            double inverseCell_;
+        };
+    }
+
+    void FaceTopology::build(const CzmFaceSet &faces, double tolerance)
+    {
+        std::size_t numFaces = faces.size();
+        std::size_t numCorners = faces.getTotalVertices();
+
+        vertices_.clear();
+        edges_.clear();
+        faceOffsets_.assign(faces.getOffsets().begin(), faces.getOffsets().end());
+        faceVertices_.assign(numCorners, 0);
+        faceEdges_.assign(numCorners, 0);
+        vertexFirstFace_.clear();
+        vertexFirstCorner_.clear();
+
+        // Deduplicate vertices
+        VertexWelder welder(vertices_, tolerance, numCorners);
+        for (std::size_t f = 0; f < numFaces; ++f)
+        {
+            for (std::size_t k = 0; k < faces.getNumVertices(f); ++k)
+            {
+                std::uint32_t id = welder.insert(faces.getVertex(f, k));
+                faceVertices_[faceOffsets_[f] + k] = id;
+                if (id == vertexFirstFace_.size())
+                {
+                    vertexFirstFace_.push_back(static_cast<std::uint32_t>(f));
+                    vertexFirstCorner_.push_back(static_cast<std::uint8_t>(k));
+                }
+            }
+        }
+
+        // Deduplicate edges on their unordered vertex id pair
+        std::unordered_map<std::uint64_t, std::uint32_t> edgeIds;
+        edgeIds.reserve(numCorners);
+        std::vector<std::uint32_t> edgeFaceCounts;
+        for (std::size_t f = 0; f < numFaces; ++f)
+        {
+            std::size_t first = faceOffsets_[f];
+            std::size_t count = faceOffsets_[f + 1] - first;
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                std::uint32_t a = faceVertices_[first + k];
+                std::uint32_t b = faceVertices_[first + (k + 1) % count];
+                std::uint64_t key = (std::uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+
+                auto inserted = edgeIds.emplace(key, static_cast<std::uint32_t>(edges_.size()));
+                if (inserted.second)
+                {
+                    edges_.push_back(TopologyEdge{a, b});
+                    edgeFaceCounts.push_back(0);
+                }
+                std::uint32_t edge = inserted.first->second;
+                faceEdges_[first + k] = edge;
+                ++edgeFaceCounts[edge];
+            }
+        }
+
+        // Edge -> face adjacency by counting sort; faces come out ascending
+        edgeFaceOffsets_.assign(edges_.size() + 1, 0);
+        for (std::size_t e = 0; e < edges_.size(); ++e)
+        {
+            edgeFaceOffsets_[e + 1] = edgeFaceOffsets_[e] + edgeFaceCounts[e];
+        }
+        edgeFaces_.assign(edgeFaceOffsets_.back(), 0);
+        std::vector<std::size_t> cursor(edgeFaceOffsets_.begin(), edgeFaceOffsets_.end() - 1);
+        for (std::size_t f = 0; f < numFaces; ++f)
+        {
+            for (std::size_t i = faceOffsets_[f]; i < faceOffsets_[f + 1]; ++i)
+            {
+                edgeFaces_[cursor[faceEdges_[i]]++] = static_cast<std::uint32_t>(f);
+            }
+        }
+    }
+
+    std::size_t FaceTopology::countEdgePoints(int pointsPerEdge) const
+    {
+        if (pointsPerEdge < 2)
+            return 0;
+        return vertices_.size() + edges_.size() * static_cast<std::size_t>(pointsPerEdge - 2);
+    }
+
+    CzmPointCloud FaceTopology::generateEdgePoints(int pointsPerEdge) const
+    {
+        CzmPointCloud cloud;
+        if (pointsPerEdge < 2)
+            return cloud;
+        cloud.reserve(countEdgePoints(pointsPerEdge));
+
+        for (std::size_t v = 0; v < vertices_.size(); ++v)
+        {
+            CZM_Point point(vertices_[v], PointType::EDGE_POINT);
+            point.setEdgeIndex(vertexFirstCorner_[v]);
+            cloud.append(point, vertexFirstFace_[v]);
+        }
+
+        for (std::size_t e = 0; e < edges_.size(); ++e)
+        {
+            // Local index of the edge in its first face
+            std::uint32_t face = edgeFaces_[edgeFaceOffsets_[e]];
+            int local = 0;
+            while (faceEdges_[faceOffsets_[face] + local] != e)
+                ++local;
+
+            const Vec3D &start = vertices_[edges_[e].start];
+            const Vec3D &end = vertices_[edges_[e].end];
+            for (int i = 1; i < pointsPerEdge - 1; ++i)
+            {
+                double t = static_cast<double>(i) / (pointsPerEdge - 1);
+                CZM_Point point(start + t * (end - start), PointType::EDGE_POINT);
+                point.setEdgeIndex(local);
+                cloud.append(point, face);
+            }
+        }
+        return cloud;
+    }
+
+} // namespace czm_face
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "vec3d/vec3d.h"
+#include "czm_face_set.hpp"
+#include "czm_point_cloud.hpp"
+
+namespace czm_face
+{
+
+    // Edge between two deduplicated vertices, oriented as in the first face using it
+    struct TopologyEdge
+    {
+        std::uint32_t start;
+        std::uint32_t end;
+    };
+
+    // Shared vertex and edge topology of a face set. Vertices closer than the
+    // tolerance are merged (exact coordinate match for tolerance 0) through a
+    // hash of quantized coordinates, and edges are deduplicated through a
+    // hash of their vertex id pairs. Adjacency is stored in compressed sparse
+    // row form: the entries of face f are [offsets[f], offsets[f + 1]).
+    class FaceTopology
+    {
+    public:
+        FaceTopology() = default;
+        ~FaceTopology() = default;
+
+        // Allow copying
+        FaceTopology(const FaceTopology &) = default;
+        FaceTopology &operator=(const FaceTopology &) = default;
+
+        // Allow moving
+        FaceTopology(FaceTopology &&) = default;
+        FaceTopology &operator=(FaceTopology &&) = default;
+
+        // Build the topology of a face set (replaces any previous build)
+        void build(const CzmFaceSet &faces, double tolerance = 0.0);
+
+        // Get counts
+        std::size_t getNumFaces() const { return faceOffsets_.empty() ? 0 : faceOffsets_.size() - 1; }
+        std::size_t getNumVertices() const { return vertices_.size(); }
+        std::size_t getNumEdges() const { return edges_.size(); }
+
+        // Get deduplicated vertices and edges
+        const std::vector<Vec3D> &getVertices() const { return vertices_; }
+        const std::vector<TopologyEdge> &getEdges() const { return edges_; }
+
+        // Face -> vertex and face -> edge adjacency. Both share the offsets;
+        // local edge k of a face runs from its local vertex k to k + 1.
+        const std::vector<std::size_t> &getFaceOffsets() const { return faceOffsets_; }
+        const std::vector<std::uint32_t> &getFaceVertices() const { return faceVertices_; }
+        const std::vector<std::uint32_t> &getFaceEdges() const { return faceEdges_; }
+
+        // Edge -> face adjacency, faces in ascending order
+        const std::vector<std::size_t> &getEdgeFaceOffsets() const { return edgeFaceOffsets_; }
+        const std::vector<std::uint32_t> &getEdgeFaces() const { return edgeFaces_; }
+
+        // Get number of faces sharing an edge (1 for boundary edges)
+        std::size_t getNumEdgeFaces(std::size_t edge) const { return edgeFaceOffsets_[edge + 1] - edgeFaceOffsets_[edge]; }
+
+        // Count the points generateEdgePoints produces
+        std::size_t countEdgePoints(int pointsPerEdge) const;
+
+        // Generate edge points with every vertex and every shared edge emitted
+        // once: each vertex, then pointsPerEdge - 2 interior points per edge.
+        // Points are attributed to the first face using the vertex or edge,
+        // with that face's local edge index (a vertex belongs to the edge
+        // starting at it).
+        CzmPointCloud generateEdgePoints(int pointsPerEdge) const;
+
+    private:
+        std::vector<Vec3D> vertices_;                 // Deduplicated vertices
+        std::vector<TopologyEdge> edges_;             // Deduplicated edges
+        std::vector<std::size_t> faceOffsets_;        // Face CSR offsets
+        std::vector<std::uint32_t> faceVertices_;     // Face -> vertex ids
+        std::vector<std::uint32_t> faceEdges_;        // Face -> edge ids
+        std::vector<std::size_t> edgeFaceOffsets_;    // Edge CSR offsets
+        std::vector<std::uint32_t> edgeFaces_;        // Edge -> face ids
+        std::vector<std::uint32_t> vertexFirstFace_;  // First face using each vertex
+        std::vector<std::uint8_t> vertexFirstCorner_; // Local index of the vertex in that face
+    };
+
+} // namespace czm_face
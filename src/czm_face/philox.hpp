@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace czm_face
+{
+
+    // Philox4x32-10 counter-based random number generator (Salmon et al.,
+    // "Parallel random numbers: as easy as 1, 2, 3", SC'11). Every output
+    // block is a pure function of (counter, key), so streams can be split
+    // by key and indexed without any shared state.
+    class Philox4x32
+    {
+    public:
+        using Counter = std::array<std::uint32_t, 4>;
+        using Key = std::array<std::uint32_t, 2>;
+
+        static constexpr int kRounds = 10;
+
+        // Encrypt one counter block with a key
+        static constexpr Counter generate(Counter counter, Key key) noexcept
+        {
+            for (int round = 0; round < kRounds; ++round)
+            {
+                if (round > 0)
+                {
+                    key[0] += kWeyl0;
+                    key[1] += kWeyl1;
+                }
+                std::uint64_t product0 = std::uint64_t(kMultiplier0) * counter[0];
+                std::uint64_t product1 = std::uint64_t(kMultiplier1) * counter[2];
+                counter = Counter{static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+                                  static_cast<std::uint32_t>(product1),
+                                  static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+                                  static_cast<std::uint32_t>(product0)};
+            }
+            return counter;
+        }
+
+    private:
+        static constexpr std::uint32_t kMultiplier0 = 0xD2511F53u;
+        static constexpr std::uint32_t kMultiplier1 = 0xCD9E8D57u;
+        static constexpr std::uint32_t kWeyl0 = 0x9E3779B9u;
+        static constexpr std::uint32_t kWeyl1 = 0xBB67AE85u;
+    };
+
+    // Sequential random numbers of one (seed, stream) pair. Block i of the
+    // stream is Philox4x32(counter = {i, stream}, key = seed), so the values
+    // depend only on the seed, the stream id and the position, never on
+    // which thread draws them. Satisfies UniformRandomBitGenerator.
+    class PhiloxStream
+    {
+    public:
+        using result_type = std::uint32_t;
+
+        PhiloxStream(std::uint64_t seed, std::uint64_t stream) noexcept
+            : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+              stream_(stream)
+        {
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        // Next 32 random bits
+        result_type operator()() noexcept
+        {
+            if (index_ == 4)
+            {
+                Philox4x32::Counter counter{static_cast<std::uint32_t>(block_), static_cast<std::uint32_t>(block_ >> 32),
+                                            static_cast<std::uint32_t>(stream_), static_cast<std::uint32_t>(stream_ >> 32)};
+                buffer_ = Philox4x32::generate(counter, key_);
+                ++block_;
+                index_ = 0;
+            }
+            return buffer_[index_++];
+        }
+
+        // Next uniform double in [0, 1) with 53 random bits. Unlike the
+        // std distributions this is identical on every standard library.
+        double nextDouble() noexcept
+        {
+            std::uint64_t high = (*this)() >> 5;
+            std::uint64_t low = (*this)() >> 6;
+            return static_cast<double>((high << 26) | low) * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        Philox4x32::Key key_;          // Seed
+        std::uint64_t stream_;         // Stream id
+        std::uint64_t block_ = 0;      // Next block index
+        Philox4x32::Counter buffer_{}; // Current block
+        int index_ = 4;                // Next word of the current block
+    };
+
+} // namespace czm_face
@@ -0,0 +1,172 @@
+#include "point_generation_engine.hpp"
+#include "reference_pattern.hpp"
+#include <algorithm>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        // Faces per task: enough tasks to balance load, few enough to keep overhead low
+        std::size_t grainSizeFor(std::size_t numFaces, const ThreadPool &pool)
+        {
+            std::size_t tasks = static_cast<std::size_t>(pool.getNumThreads()) * 8;
+            return std::max<std::size_t>(1, numFaces / tasks);
+        }
+
+        // Count, prefix-sum and fill: count(face, index) returns the number of
+        // points of a face, generate(face, index, output, weights) writes
+        // exactly that many (weights is empty unless withWeights is set)
+        template <typename Count, typename Generate>
+        FacePointSet generateForFaces(Span<const CzmFace> faces, ThreadPool &pool, bool withWeights,
+                                      Count count, Generate generate)
+        {
+            FacePointSet result;
+            std::size_t numFaces = faces.size();
+            std::size_t grainSize = grainSizeFor(numFaces, pool);
+
+            // Count points of every face
+            result.offsets.assign(numFaces + 1, 0);
+            pool.parallelFor(numFaces, grainSize, [&](std::size_t begin, std::size_t end)
+                             {
+                                 for (std::size_t f = begin; f < end; ++f)
+                                 {
+                                     result.offsets[f + 1] = count(faces[f], f);
+                                 } });
+
+            // Prefix sum turns counts into offsets
+            for (std::size_t f = 0; f < numFaces; ++f)
+            {
+                result.offsets[f + 1] += result.offsets[f];
+            }
+
+            // Generate every face's points directly into its slot
+            result.points.resize(result.offsets[numFaces]);
+            if (withWeights)
+                result.weights.resize(result.offsets[numFaces]);
+            pool.parallelFor(numFaces, grainSize, [&](std::size_t begin, std::size_t end)
+                             {
+                                 for (std::size_t f = begin; f < end; ++f)
+                                 {
+                                     std::size_t size = result.offsets[f + 1] - result.offsets[f];
+                                     Span<CZM_Point> slot(result.points.data() + result.offsets[f], size);
+                                     Span<double> weightSlot(withWeights ? result.weights.data() + result.offsets[f] : nullptr,
+                                                             withWeights ? size : 0);
+                                     generate(faces[f], f, slot, weightSlot);
+                                 } });
+
+            return result;
+        }
+
+        FacePointSet generatePointGridForFaces(Span<const CzmFace> faces, PointGenerationMethod method,
+                                               int pointsPerEdge, ThreadPool &pool, bool withWeights)
+        {
+            // Methods with the same layout on every face of a shape get the
+            // patterns once (building them if too dense to cache), so every
+            // face is a pure transform of them
+            ReferencePatternSet patterns(method, pointsPerEdge);
+            if (patterns.get(ReferenceShape::TRIANGLE))
+            {
+                auto patternOf = [&](const CzmFace &face)
+                { return patterns.get(face.getReferenceShape()); };
+                return generateForFaces(
+                    faces, pool, withWeights,
+                    [&](const CzmFace &face, std::size_t)
+                    { return (face.getNumVertices() >= 3) ? patternOf(face)->size() : std::size_t(0); },
+                    [&](const CzmFace &face, std::size_t, Span<CZM_Point> output, Span<double> weights)
+                    {
+                        if (withWeights)
+                            face.mapReferencePattern(*patternOf(face), output, weights);
+                        else
+                            face.mapReferencePattern(*patternOf(face), output);
+                    });
+            }
+
+            return generateForFaces(
+                faces, pool, withWeights,
+                [&](const CzmFace &face, std::size_t)
+                { return face.countPoints(pointsPerEdge, method); },
+                [&](const CzmFace &face, std::size_t, Span<CZM_Point> output, Span<double> weights)
+                {
+                    if (withWeights)
+                        face.generatePointGrid(pointsPerEdge, method, output, weights);
+                    else
+                        face.generatePointGrid(pointsPerEdge, method, output);
+                });
+        }
+
+        FacePointSet generateEqualAreaForFaces(Span<const CzmFace> faces, int numPoints,
+                                               const EqualAreaOptions &options, ThreadPool &pool,
+                                               bool withWeights)
+        {
+            auto faceOptions = [&](std::size_t index)
+            {
+                EqualAreaOptions result = options;
+                result.faceId += index;
+                return result;
+            };
+            return generateForFaces(
+                faces, pool, withWeights,
+                [&](const CzmFace &face, std::size_t index)
+                { return face.countEqualAreaPoints(numPoints, faceOptions(index)); },
+                [&](const CzmFace &face, std::size_t index, Span<CZM_Point> output, Span<double> weights)
+                {
+                    if (withWeights)
+                        face.generateEqualAreaPoints(numPoints, faceOptions(index), output, weights);
+                    else
+                        face.generateEqualAreaPoints(numPoints, faceOptions(index), output);
+                });
+        }
+    }
+
+    FacePointSet generatePointsForFaces(Span<const CzmFace> faces,
+                                        PointGenerationMethod method,
+                                        int pointsPerEdge,
+                                        ThreadPool &pool)
+    {
+        return generatePointGridForFaces(faces, method, pointsPerEdge, pool, false);
+    }
+
+    FacePointSet generateWeightedPointsForFaces(Span<const CzmFace> faces,
+                                                PointGenerationMethod method,
+                                                int pointsPerEdge,
+                                                ThreadPool &pool)
+    {
+        return generatePointGridForFaces(faces, method, pointsPerEdge, pool, true);
+    }
+
+    FacePointSet generateEqualAreaPointsForFaces(Span<const CzmFace> faces,
+                                                 int numPoints,
+                                                 ThreadPool &pool)
+    {
+        return generateEqualAreaPointsForFaces(faces, numPoints, EqualAreaOptions(), pool);
+    }
+
+    FacePointSet generateEqualAreaPointsForFaces(Span<const CzmFace> faces,
+                                                 int numPoints,
+                                                 const EqualAreaOptions &options,
+                                                 ThreadPool &pool)
+    {
+        return generateEqualAreaForFaces(faces, numPoints, options, pool, false);
+    }
+
+    FacePointSet generateWeightedEqualAreaPointsForFaces(Span<const CzmFace> faces,
+                                                         int numPoints,
+                                                         const EqualAreaOptions &options,
+                                                         ThreadPool &pool)
+    {
+        return generateEqualAreaForFaces(faces, numPoints, options, pool, true);
+    }
+
+    CzmPointCloud toPointCloud(const FacePointSet &pointSet)
+    {
+        CzmPointCloud cloud;
+        cloud.reserve(pointSet.points.size());
+        for (std::size_t face = 0; face < pointSet.getNumFaces(); ++face)
+        {
+            cloud.append(pointSet.getFacePoints(face), static_cast<std::uint32_t>(face));
+        }
+        return cloud;
+    }
+
+} // namespace czm_face
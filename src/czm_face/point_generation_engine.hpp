@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "czm_face.hpp"
+#include "czm_point.hpp"
+#include "czm_point_cloud.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+namespace czm_face
+{
+
+    // Points generated for many faces, stored in one buffer. The points of
+    // face i occupy [offsets[i], offsets[i + 1]) and their edge indices refer
+    // to the edges of that face.
+    struct FacePointSet
+    {
+        std::vector<CZM_Point> points;
+        std::vector<std::size_t> offsets;
+        std::vector<double> weights; // Point weights (empty unless requested)
+
+        // Get number of faces
+        std::size_t getNumFaces() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+        // Get the points of one face
+        Span<const CZM_Point> getFacePoints(std::size_t face) const
+        {
+            return Span<const CZM_Point>(points.data() + offsets[face], offsets[face + 1] - offsets[face]);
+        }
+
+        // Get the point weights of one face
+        Span<const double> getFaceWeights(std::size_t face) const
+        {
+            return Span<const double>(weights.data() + offsets[face], offsets[face + 1] - offsets[face]);
+        }
+    };
+
+    // Generate points on every face in parallel. Faces are distributed over
+    // the pool, per-face point counts are turned into offsets with a prefix
+    // sum, and all points are written into one preallocated buffer.
+    FacePointSet generatePointsForFaces(Span<const CzmFace> faces,
+                                        PointGenerationMethod method,
+                                        int pointsPerEdge,
+                                        ThreadPool &pool = ThreadPool::getDefault());
+
+    // Generate points and their weights (see CzmFace::generatePointGrid) on
+    // every face in parallel, in the same pass
+    FacePointSet generateWeightedPointsForFaces(Span<const CzmFace> faces,
+                                                PointGenerationMethod method,
+                                                int pointsPerEdge,
+                                                ThreadPool &pool = ThreadPool::getDefault());
+
+    // Generate equal area points on every face in parallel (see generatePointsForFaces)
+    FacePointSet generateEqualAreaPointsForFaces(Span<const CzmFace> faces,
+                                                 int numPoints,
+                                                 ThreadPool &pool = ThreadPool::getDefault());
+
+    // Generate equal area points with options. Face i uses the random stream
+    // options.faceId + i, so the result is the same for any thread count.
+    FacePointSet generateEqualAreaPointsForFaces(Span<const CzmFace> faces,
+                                                 int numPoints,
+                                                 const EqualAreaOptions &options,
+                                                 ThreadPool &pool = ThreadPool::getDefault());
+
+    // Generate equal area points with their tributary areas
+    FacePointSet generateWeightedEqualAreaPointsForFaces(Span<const CzmFace> faces,
+                                                         int numPoints,
+                                                         const EqualAreaOptions &options,
+                                                         ThreadPool &pool = ThreadPool::getDefault());
+
+    // Convert generated points to a compact point cloud (face ids are face indices)
+    CzmPointCloud toPointCloud(const FacePointSet &pointSet);
+
+} // namespace czm_face
@@ -0,0 +1,192 @@
+#include "point_stream.hpp"
+#include <algorithm>
+
+namespace czm_face
+{
+
+    PointStream::PointStream(const CzmFace *faces, const CzmFaceSet *faceSet, std::size_t numFaces,
+                             std::size_t chunkSize)
+        : faces_(faces), faceSet_(faceSet), numFaces_(numFaces), chunkSize_(std::max<std::size_t>(chunkSize, 1))
+    {
+    }
+
+    PointStream::PointStream(Span<const CzmFace> faces, PointGenerationMethod method, int pointsPerEdge,
+                             std::size_t chunkSize)
+        : PointStream(faces.data(), nullptr, faces.size(), chunkSize)
+    {
+        method_ = method;
+        density_ = pointsPerEdge;
+        patterns_ = ReferencePatternSet(method, pointsPerEdge);
+    }
+
+    PointStream::PointStream(const CzmFaceSet &faces, PointGenerationMethod method, int pointsPerEdge,
+                             std::size_t chunkSize)
+        : PointStream(nullptr, &faces, faces.size(), chunkSize)
+    {
+        method_ = method;
+        density_ = pointsPerEdge;
+        patterns_ = ReferencePatternSet(method, pointsPerEdge);
+    }
+
+    PointStream PointStream::equalArea(Span<const CzmFace> faces, int numPoints, const EqualAreaOptions &options,
+                                       std::size_t chunkSize)
+    {
+        PointStream stream(faces.data(), nullptr, faces.size(), chunkSize);
+        stream.equalArea_ = true;
+        stream.density_ = numPoints;
+        stream.options_ = options;
+        return stream;
+    }
+
+    PointStream PointStream::equalArea(const CzmFaceSet &faces, int numPoints, const EqualAreaOptions &options,
+                                       std::size_t chunkSize)
+    {
+        PointStream stream(nullptr, &faces, faces.size(), chunkSize);
+        stream.equalArea_ = true;
+        stream.density_ = numPoints;
+        stream.options_ = options;
+        return stream;
+    }
+
+    void PointStream::reset()
+    {
+        nextFace_ = 0;
+        streamed_ = 0;
+        splitPoints_.clear();
+        splitWeights_.clear();
+        splitSize_ = 0;
+        splitOffset_ = 0;
+    }
+
+    const CzmFace &PointStream::getFace(std::size_t i, CzmFace &scratch) const
+    {
+        if (faces_)
+            return faces_[i];
+        scratch = faceSet_->getFace(i);
+        return scratch;
+    }
+
+    std::size_t PointStream::countPoints(const CzmFace &face, std::size_t index) const
+    {
+        if (!equalArea_)
+        {
+            const ReferencePattern *pattern = patterns_.get(face.getReferenceShape());
+            if (pattern)
+                return (face.getNumVertices() >= 3) ? pattern->size() : 0;
+            return face.countPoints(density_, method_);
+        }
+
+        EqualAreaOptions options = options_;
+        options.faceId += index;
+        return face.countEqualAreaPoints(density_, options);
+    }
+
+    std::size_t PointStream::generate(const CzmFace &face, std::size_t index, Span<CZM_Point> output,
+                                      Span<double> weights) const
+    {
+        if (!equalArea_)
+        {
+            // Map the stream's patterns, which were built once if too dense to cache
+            const ReferencePattern *pattern = patterns_.get(face.getReferenceShape());
+            if (pattern)
+            {
+                return withWeights_ ? face.mapReferencePattern(*pattern, output, weights)
+                                    : face.mapReferencePattern(*pattern, output);
+            }
+            return withWeights_ ? face.generatePointGrid(density_, method_, output, weights)
+                                : face.generatePointGrid(density_, method_, output);
+        }
+
+        EqualAreaOptions options = options_;
+        options.faceId += index;
+        return withWeights_ ? face.generateEqualAreaPoints(density_, options, output, weights)
+                            : face.generateEqualAreaPoints(density_, options, output);
+    }
+
+    bool PointStream::next(PointChunk &chunk)
+    {
+        points_.resize(chunkSize_);
+        faceIds_.resize(chunkSize_);
+        weights_.resize(withWeights_ ? chunkSize_ : 0);
+
+        std::size_t count = 0;
+        CzmFace scratch;
+        while (count < chunkSize_)
+        {
+            // Rest of a split face first: mapped piece by piece from its
+            // pattern, or copied from the points generated for it
+            if (splitOffset_ < splitSize_)
+            {
+                std::size_t n = std::min(splitSize_ - splitOffset_, chunkSize_ - count);
+                if (splitPoints_.empty())
+                {
+                    const CzmFace &face = getFace(splitFace_, scratch);
+                    const ReferencePattern &pattern = *patterns_.get(face.getReferenceShape());
+                    Span<CZM_Point> output(points_.data() + count, n);
+                    if (withWeights_)
+                        face.mapReferencePattern(pattern, splitOffset_, output, Span<double>(weights_.data() + count, n));
+                    else
+                        face.mapReferencePattern(pattern, splitOffset_, output);
+                }
+                else
+                {
+                    std::copy_n(splitPoints_.begin() + splitOffset_, n, points_.begin() + count);
+                    if (withWeights_)
+                        std::copy_n(splitWeights_.begin() + splitOffset_, n, weights_.begin() + count);
+                }
+                std::fill_n(faceIds_.begin() + count, n, static_cast<std::uint32_t>(splitFace_));
+                splitOffset_ += n;
+                count += n;
+                if (splitOffset_ == splitSize_)
+                {
+                    splitPoints_.clear();
+                    splitWeights_.clear();
+                    splitSize_ = 0;
+                    splitOffset_ = 0;
+                }
+                continue;
+            }
+            if (nextFace_ >= numFaces_)
+                break;
+
+            // Count first; faces that fit are generated straight into the chunk
+            const CzmFace &face = getFace(nextFace_, scratch);
+            std::size_t n = countPoints(face, nextFace_);
+            std::size_t space = chunkSize_ - count;
+            if (n <= space)
+            {
+                Span<double> weights = withWeights_ ? Span<double>(weights_.data() + count, n) : Span<double>();
+                generate(face, nextFace_, Span<CZM_Point>(points_.data() + count, n), weights);
+                std::fill_n(faceIds_.begin() + count, n, static_cast<std::uint32_t>(nextFace_));
+                count += n;
+                ++nextFace_;
+                continue;
+            }
+
+            // A face that fits in a chunk starts the next one; larger faces
+            // are split, generating their points once unless a pattern maps
+            // them piece by piece
+            if (n <= chunkSize_ && count > 0)
+                break;
+            if (!patterns_.get(face.getReferenceShape()))
+            {
+                splitPoints_.resize(n);
+                splitWeights_.resize(withWeights_ ? n : 0);
+                generate(face, nextFace_, splitPoints_, splitWeights_);
+            }
+            splitSize_ = n;
+            splitFace_ = nextFace_++;
+        }
+
+        if (count == 0)
+            return false;
+
+        chunk.points = Span<const CZM_Point>(points_.data(), count);
+        chunk.faceIds = Span<const std::uint32_t>(faceIds_.data(), count);
+        chunk.weights = withWeights_ ? Span<const double>(weights_.data(), count) : Span<const double>();
+        chunk.firstPoint = streamed_;
+        streamed_ += count;
+        return true;
+    }
+
+} // namespace czm_face
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "czm_face.hpp"
+#include "czm_face_set.hpp"
+#include "czm_point.hpp"
+#include "reference_pattern.hpp"
+#include "span.hpp"
+
+namespace czm_face
+{
+
+    // Points of one streamed chunk. The views stay valid until the next call
+    // to PointStream::next.
+    struct PointChunk
+    {
+        Span<const CZM_Point> points;      // Positions, types and face-local edge indices
+        Span<const std::uint32_t> faceIds; // Face each point was generated on
+        Span<const double> weights;        // Point weights (empty unless requested)
+        std::size_t firstPoint = 0;        // Stream index of the first point
+    };
+
+    // Pull-based point generation over many faces in fixed-size chunks, for
+    // outputs too large to hold at once. Faces are walked in order and a
+    // chunk holds at most chunkSize points; a face that does not fit in the
+    // rest of a chunk starts the next one, and only faces with more than
+    // chunkSize points are split. Every face is counted before it is
+    // generated, so it is generated once. Reference pattern methods
+    // (EDGE_ONLY, PARAMETRIC_GRID, GAUSS and LOBATTO) map split faces piece
+    // by piece; other methods hold a split face in full. Memory stays at
+    // chunkSize points plus the largest such face, whatever the total, and
+    // face sets are read one face at a time. Points are the same as generatePointsForFaces and
+    // generateEqualAreaPointsForFaces produce, in the same order.
+    class PointStream
+    {
+    public:
+        static constexpr std::size_t kDefaultChunkSize = 65536;
+
+        // Stream point grid points (see CzmFace::generatePointGrid)
+        PointStream(Span<const CzmFace> faces, PointGenerationMethod method, int pointsPerEdge,
+                    std::size_t chunkSize = kDefaultChunkSize);
+        PointStream(const CzmFaceSet &faces, PointGenerationMethod method, int pointsPerEdge,
+                    std::size_t chunkSize = kDefaultChunkSize);
+
+        // Stream equal area points; face i uses the random stream options.faceId + i
+        static PointStream equalArea(Span<const CzmFace> faces, int numPoints, const EqualAreaOptions &options,
+                                     std::size_t chunkSize = kDefaultChunkSize);
+        static PointStream equalArea(const CzmFaceSet &faces, int numPoints, const EqualAreaOptions &options,
+                                     std::size_t chunkSize = kDefaultChunkSize);
+
+        ~PointStream() = default;
+
+        // Prevent copying (chunks point into the stream's buffers)
+        PointStream(const PointStream &) = delete;
+        PointStream &operator=(const PointStream &) = delete;
+
+        // Allow moving
+        PointStream(PointStream &&) = default;
+        PointStream &operator=(PointStream &&) = default;
+
+        // Also produce point weights (see generatePointGrid and
+        // generateEqualAreaPoints with weights)
+        void setWithWeights(bool withWeights) { withWeights_ = withWeights; }
+
+        // Get the next chunk; returns false once every face is done
+        bool next(PointChunk &chunk);
+
+        // Restart from the first face
+        void reset();
+
+        // Call consumer(const PointChunk &) for every remaining chunk; returns
+        // the number of points streamed
+        template <typename Consumer>
+        std::size_t forEachChunk(Consumer &&consumer)
+        {
+            std::size_t total = 0;
+            PointChunk chunk;
+            while (next(chunk))
+            {
+                consumer(static_cast<const PointChunk &>(chunk));
+                total += chunk.points.size();
+            }
+            return total;
+        }
+
+        // Get number of faces and maximum points per chunk
+        std::size_t getNumFaces() const { return numFaces_; }
+        std::size_t getChunkSize() const { return chunkSize_; }
+
+    private:
+        PointStream(const CzmFace *faces, const CzmFaceSet *faceSet, std::size_t numFaces, std::size_t chunkSize);
+
+        // Get face i (built from the face set into scratch if needed)
+        const CzmFace &getFace(std::size_t i, CzmFace &scratch) const;
+
+        // Get the number of points of a face
+        std::size_t countPoints(const CzmFace &face, std::size_t index) const;
+
+        // Generate the points of a face; returns its point count, writing at most output.size()
+        std::size_t generate(const CzmFace &face, std::size_t index, Span<CZM_Point> output,
+                             Span<double> weights) const;
+
+        const CzmFace *faces_ = nullptr;       // Faces, or
+        const CzmFaceSet *faceSet_ = nullptr;  // face set the faces are read from
+        std::size_t numFaces_ = 0;             // Number of faces
+        std::size_t chunkSize_ = 0;            // Points per chunk
+        bool equalArea_ = false;               // Equal area points (else point grid)
+        PointGenerationMethod method_ = PointGenerationMethod::EDGE_AND_INTERIOR;
+        int density_ = 0;                      // Points per edge or equal area point count
+        EqualAreaOptions options_;             // Equal area options
+        ReferencePatternSet patterns_;         // Patterns of reference pattern methods
+        bool withWeights_ = false;             // Produce point weights
+
+        std::size_t nextFace_ = 0;             // Next face to generate
+        std::size_t streamed_ = 0;             // Points returned so far
+        std::vector<CZM_Point> points_;        // Chunk buffers
+        std::vector<std::uint32_t> faceIds_;
+        std::vector<double> weights_;
+        std::vector<CZM_Point> splitPoints_;   // Points of a split face (empty for patterns)
+        std::vector<double> splitWeights_;
+        std::size_t splitFace_ = 0;            // Face of the split points
+        std::size_t splitSize_ = 0;            // Points of the split face
+        std::size_t splitOffset_ = 0;          // First split point not yet returned
+    };
+
+} // namespace czm_face
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace czm_face
+{
+
+    // Point of a planar polygon
+    struct Point2
+    {
+        double x, y;
+    };
+
+    using Polygon2 = std::vector<Point2>;
+
+    // Clip a polygon of count vertices to the half-plane nx * x + ny * y <= c
+    // (Sutherland-Hodgman), passing the vertices of the result to emit. Exact
+    // for convex input; a concave polygon may gain zero-area bridges, which
+    // keeps its area right. The result has at most 3 * count / 2 vertices.
+    template <typename Emit>
+    inline void clipPolygon(const Point2 *polygon, std::size_t count, double nx, double ny, double c, Emit &&emit)
+    {
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const Point2 &a = polygon[k];
+            const Point2 &b = polygon[(k + 1) % count];
+            double da = nx * a.x + ny * a.y - c;
+            double db = nx * b.x + ny * b.y - c;
+            if (da <= 0.0)
+                emit(a);
+            if ((da < 0.0 && db > 0.0) || (da > 0.0 && db < 0.0))
+            {
+                double t = da / (da - db);
+                emit(Point2{a.x + t * (b.x - a.x), a.y + t * (b.y - a.y)});
+            }
+        }
+    }
+
+    // Clip a polygon to the half-plane nx * x + ny * y <= c; the result is
+    // written to clipped
+    inline void clipPolygon(const Polygon2 &polygon, double nx, double ny, double c, Polygon2 &clipped)
+    {
+        clipped.clear();
+        clipPolygon(polygon.data(), polygon.size(), nx, ny, c, [&clipped](const Point2 &p)
+                    { clipped.push_back(p); });
+    }
+
+    // Signed area (positive counter-clockwise) and centroid of a polygon of
+    // count vertices
+    inline double polygonAreaCentroid(const Point2 *polygon, std::size_t count, Point2 &centroid)
+    {
+        double area2 = 0.0, cx = 0.0, cy = 0.0;
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const Point2 &a = polygon[k];
+            const Point2 &b = polygon[(k + 1) % count];
+            double cross = a.x * b.y - b.x * a.y;
+            area2 += cross;
+            cx += (a.x + b.x) * cross;
+            cy += (a.y + b.y) * cross;
+        }
+        if (area2 == 0.0)
+        {
+            centroid = count > 0 ? polygon[0] : Point2{0.0, 0.0};
+            return 0.0;
+        }
+        centroid = Point2{cx / (3.0 * area2), cy / (3.0 * area2)};
+        return 0.5 * area2;
+    }
+
+    // Signed area (positive counter-clockwise) and centroid of a polygon
+    inline double polygonAreaCentroid(const Polygon2 &polygon, Point2 &centroid)
+    {
+        return polygonAreaCentroid(polygon.data(), polygon.size(), centroid);
+    }
+
+    // Polar second moment of a counter-clockwise polygon about a point: the
+    // integral of the squared distance to it over the polygon
+    inline double polygonSecondMoment(const Polygon2 &polygon, const Point2 &origin)
+    {
+        double moment = 0.0;
+        std::size_t count = polygon.size();
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            double ax = polygon[k].x - origin.x, ay = polygon[k].y - origin.y;
+            double bx = polygon[(k + 1) % count].x - origin.x, by = polygon[(k + 1) % count].y - origin.y;
+            double cross = ax * by - bx * ay;
+            moment += cross * (ax * ax + ax * bx + bx * bx + ay * ay + ay * by + by * by);
+        }
+        return moment / 12.0;
+    }
+
+    // Signed area of a polygon of count vertices
+    inline double polygonArea(const Point2 *polygon, std::size_t count)
+    {
+        Point2 centroid;
+        return polygonAreaCentroid(polygon, count, centroid);
+    }
+
+    // Signed area of a polygon
+    inline double polygonArea(const Polygon2 &polygon)
+    {
+        return polygonArea(polygon.data(), polygon.size());
+    }
+
+} // namespace czm_face
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <cstdint>
+
+namespace czm_face
+{
+
+    // Supported quadrature orders (integration points per direction)
+    constexpr int kMinQuadratureOrder = 1;
+    constexpr int kMaxQuadratureOrder = 10;
+    constexpr int kMaxReferencePoints = kMaxQuadratureOrder * kMaxQuadratureOrder;
+
+    enum class QuadratureFamily
+    {
+        GAUSS,  // Gauss-Legendre: interior points, exact to degree 2n - 1
+        LOBATTO // Gauss-Lobatto: includes the end points, exact to degree 2n - 3
+    };
+
+    enum class ReferenceShape
+    {
+        TRIANGLE, // xi, eta >= 0, xi + eta <= 1
+        QUAD      // [0,1]^2
+    };
+
+    // One-dimensional rule on [0,1]
+    struct QuadratureRule1D
+    {
+        int numPoints = 0;
+        double nodes[kMaxQuadratureOrder] = {};
+        double weights[kMaxQuadratureOrder] = {};
+    };
+
+    // Rule on a reference shape. Weights integrate over the reference shape
+    // (they sum to 1/2 on the triangle and 1 on the square); edge is the face
+    // edge a point lies on (-1 for interior points), using the edge numbering
+    // of CzmFace::mapReferencePoint.
+    struct ReferenceQuadrature
+    {
+        int numPoints = 0;
+        double xi[kMaxReferencePoints] = {};
+        double eta[kMaxReferencePoints] = {};
+        double weights[kMaxReferencePoints] = {};
+        std::int8_t edge[kMaxReferencePoints] = {};
+    };
+
+    namespace detail
+    {
+        // Legendre polynomial P_n(x) by the three-term recurrence
+        constexpr double legendre(int n, double x)
+        {
+            if (n == 0)
+                return 1.0;
+
+            double p0 = 1.0;
+            double p1 = x;
+            for (int k = 1; k < n; ++k)
+            {
+                double p2 = ((2 * k + 1) * x * p1 - k * p0) / (k + 1);
+                p0 = p1;
+                p1 = p2;
+            }
+            return p1;
+        }
+
+        // x P_n(x) - P_{n-1}(x) = (x^2 - 1) P_n'(x) / n, which has the roots
+        // of P_n' inside (-1, 1)
+        constexpr double legendreDerivativeRoots(int n, double x)
+        {
+            return x * legendre(n, x) - legendre(n - 1, x);
+        }
+
+        // Root of f in (lo, hi) by bisection; f(lo) and f(hi) differ in sign
+        template <typename F>
+        constexpr double bisect(F f, double lo, double hi)
+        {
+            bool negativeAtLo = f(lo) < 0.0;
+            for (int it = 0; it < 128; ++it)
+            {
+                double mid = 0.5 * (lo + hi);
+                if (mid <= lo || mid >= hi)
+                    break;
+                if ((f(mid) < 0.0) == negativeAtLo)
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            return 0.5 * (lo + hi);
+        }
+
+        // Roots of P_n in ascending order. Roots of P_n interlace with those
+        // of P_{n-1}, so every root is bracketed by the previous level.
+        constexpr void legendreRoots(int n, double (&roots)[kMaxQuadratureOrder])
+        {
+            double previous[kMaxQuadratureOrder + 1] = {};
+            int numPrevious = 0;
+            for (int m = 1; m <= n; ++m)
+            {
+                double brackets[kMaxQuadratureOrder + 1] = {};
+                brackets[0] = -1.0;
+                for (int k = 0; k < numPrevious; ++k)
+                    brackets[k + 1] = previous[k];
+                brackets[numPrevious + 1] = 1.0;
+
+                for (int k = 0; k < m; ++k)
+                {
+                    previous[k] = bisect([m](double x)
+                                         { return legendre(m, x); },
+                                         brackets[k], brackets[k + 1]);
+                }
+                numPrevious = m;
+            }
+            for (int k = 0; k < n; ++k)
+                roots[k] = previous[k];
+        }
+
+        constexpr QuadratureRule1D makeGaussRule(int n)
+        {
+            QuadratureRule1D rule;
+            double roots[kMaxQuadratureOrder] = {};
+            legendreRoots(n, roots);
+
+            // w = 2 (1 - x^2) / (n P_{n-1}(x))^2 on [-1,1], halved for [0,1]
+            rule.numPoints = n;
+            for (int k = 0; k < n; ++k)
+            {
+                double x = roots[k];
+                double p = n * legendre(n - 1, x);
+                rule.nodes[k] = 0.5 * (x + 1.0);
+                rule.weights[k] = (1.0 - x * x) / (p * p);
+            }
+            return rule;
+        }
+
+        constexpr QuadratureRule1D makeLobattoRule(int n)
+        {
+            // A Lobatto rule needs two points; order 1 falls back to the midpoint rule
+            if (n < 2)
+                return makeGaussRule(n);
+
+            // Interior nodes are the roots of P_{n-1}', which lie between
+            // consecutive roots of P_{n-1}
+            QuadratureRule1D rule;
+            double roots[kMaxQuadratureOrder] = {};
+            legendreRoots(n - 1, roots);
+
+            double nodes[kMaxQuadratureOrder] = {};
+            nodes[0] = -1.0;
+            for (int k = 0; k + 1 < n - 1; ++k)
+            {
+                nodes[k + 1] = bisect([n](double x)
+                                      { return legendreDerivativeRoots(n - 1, x); },
+                                      roots[k], roots[k + 1]);
+            }
+            nodes[n - 1] = 1.0;
+
+            // w = 2 / (n (n - 1) P_{n-1}(x)^2) on [-1,1], halved for [0,1]
+            rule.numPoints = n;
+            for (int k = 0; k < n; ++k)
+            {
+                double p = legendre(n - 1, nodes[k]);
+                rule.nodes[k] = 0.5 * (nodes[k] + 1.0);
+                rule.weights[k] = 1.0 / (n * (n - 1) * p * p);
+            }
+            rule.nodes[0] = 0.0;
+            rule.nodes[n - 1] = 1.0;
+            return rule;
+        }
+
+        constexpr QuadratureRule1D makeRule1D(QuadratureFamily family, int n)
+        {
+            return (family == QuadratureFamily::GAUSS) ? makeGaussRule(n) : makeLobattoRule(n);
+        }
+
+        // Edge of the reference point with 1D node indices (i, j); see ReferenceQuadrature
+        constexpr std::int8_t referenceEdge(ReferenceShape shape, const QuadratureRule1D &rule, int i, int j)
+        {
+            bool lowI = rule.nodes[i] == 0.0, highI = rule.nodes[i] == 1.0;
+            bool lowJ = rule.nodes[j] == 0.0, highJ = rule.nodes[j] == 1.0;
+
+            if (shape == ReferenceShape::QUAD)
+            {
+                if (lowJ && !highI)
+                    return 0;
+                if (highI && !highJ)
+                    return 1;
+                if (highJ && !lowI)
+                    return 2;
+                if (lowI && !lowJ)
+                    return 3;
+                return -1;
+            }
+
+            // Collapsed square: the row j = 1 is the apex vertex 2
+            if (lowJ && !highI)
+                return 0;
+            if (highI && !highJ)
+                return 1;
+            if (lowI || highJ)
+                return 2;
+            return -1;
+        }
+
+        // Tensor product rule on the square, or its collapsed (Duffy) form
+        // xi = u (1 - v), eta = v with Jacobian (1 - v) on the triangle. A
+        // Lobatto row at v = 1 collapses to the apex and is emitted once.
+        constexpr ReferenceQuadrature makeReferenceQuadrature(ReferenceShape shape, QuadratureFamily family, int order)
+        {
+            ReferenceQuadrature quadrature;
+            QuadratureRule1D rule = makeRule1D(family, order);
+
+            int count = 0;
+            for (int j = 0; j < rule.numPoints; ++j)
+            {
+                double v = rule.nodes[j];
+                for (int i = 0; i < rule.numPoints; ++i)
+                {
+                    double u = rule.nodes[i];
+                    double weight = rule.weights[i] * rule.weights[j];
+                    double xi = u;
+                    if (shape == ReferenceShape::TRIANGLE)
+                    {
+                        if (v == 1.0 && i > 0)
+                            break;
+                        xi = u * (1.0 - v);
+                        weight *= (1.0 - v);
+                    }
+
+                    quadrature.xi[count] = xi;
+                    quadrature.eta[count] = v;
+                    quadrature.weights[count] = weight;
+                    quadrature.edge[count] = referenceEdge(shape, rule, i, j);
+                    ++count;
+                }
+            }
+            quadrature.numPoints = count;
+            return quadrature;
+        }
+
+        struct ReferenceQuadratureTable
+        {
+            // [shape][family][order - 1]
+            ReferenceQuadrature rules[2][2][kMaxQuadratureOrder];
+        };
+
+        constexpr ReferenceQuadratureTable makeReferenceQuadratureTable()
+        {
+            ReferenceQuadratureTable table;
+            for (int shape = 0; shape < 2; ++shape)
+            {
+                for (int family = 0; family < 2; ++family)
+                {
+                    for (int order = kMinQuadratureOrder; order <= kMaxQuadratureOrder; ++order)
+                    {
+                        table.rules[shape][family][order - 1] =
+                            makeReferenceQuadrature(static_cast<ReferenceShape>(shape),
+                                                    static_cast<QuadratureFamily>(family), order);
+                    }
+                }
+            }
+            return table;
+        }
+
+        // All rules, evaluated at compile time and shared by every face
+        inline constexpr ReferenceQuadratureTable kReferenceQuadratureTable = makeReferenceQuadratureTable();
+    }
+
+    // Get a one-dimensional rule on [0,1] (numPoints is 0 for unsupported orders)
+    constexpr QuadratureRule1D getQuadratureRule1D(QuadratureFamily family, int order)
+    {
+        if (order < kMinQuadratureOrder || order > kMaxQuadratureOrder)
+            return QuadratureRule1D();
+        return detail::makeRule1D(family, order);
+    }
+
+    // Get a precomputed rule on a reference shape, or nullptr for unsupported orders
+    constexpr const ReferenceQuadrature *getReferenceQuadrature(ReferenceShape shape, QuadratureFamily family, int order)
+    {
+        if (order < kMinQuadratureOrder || order > kMaxQuadratureOrder)
+            return nullptr;
+        return &detail::kReferenceQuadratureTable.rules[static_cast<int>(shape)][static_cast<int>(family)][order - 1];
+    }
+
+} // namespace czm_face
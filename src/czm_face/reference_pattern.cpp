@@ -0,0 +1,126 @@
+#include "reference_pattern.hpp"
+#include <algorithm>
+#include <mutex>
+
+namespace czm_face
+{
+
+    void ReferencePattern::add(double pointXi, double pointEta, int pointEdge, double weight,
+                               double weightXi, double weightEta)
+    {
+        xi.push_back(pointXi);
+        eta.push_back(pointEta);
+        edge.push_back(static_cast<std::int8_t>(pointEdge));
+        measure.push_back(weight);
+        measureXi.push_back(weightXi);
+        measureEta.push_back(weightEta);
+    }
+
+    bool isReferencePatternMethod(PointGenerationMethod method)
+    {
+        switch (method)
+        {
+        case PointGenerationMethod::EDGE_ONLY:
+        case PointGenerationMethod::PARAMETRIC_GRID:
+        case PointGenerationMethod::GAUSS:
+        case PointGenerationMethod::LOBATTO:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    ReferencePattern buildReferencePattern(ReferenceShape shape, PointGenerationMethod method, int density)
+    {
+        ReferencePattern pattern;
+        pattern.shape = shape;
+        pattern.method = method;
+        pattern.density = density;
+        pattern.edgeParameters = (method == PointGenerationMethod::EDGE_ONLY);
+        visitReferencePatternPoints(shape, method, density,
+                                    [&pattern](double xi, double eta, int edge, double weight, double weightXi,
+                                               double weightEta)
+                                    { pattern.add(xi, eta, edge, weight, weightXi, weightEta); });
+        return pattern;
+    }
+
+    const ReferencePattern *ReferencePatternCache::getPattern(ReferenceShape shape, PointGenerationMethod method,
+                                                              int density)
+    {
+        if (!isReferencePatternMethod(method) || density < 1 || density > kMaxCachedDensity)
+            return nullptr;
+
+        Key key(shape, method, density);
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = patterns_.find(key);
+            if (it != patterns_.end())
+                return it->second.get();
+        }
+
+        // Build outside the lock; if another thread was faster its pattern wins
+        auto pattern = std::make_unique<const ReferencePattern>(buildReferencePattern(shape, method, density));
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        return patterns_.emplace(key, std::move(pattern)).first->second.get();
+    }
+
+    std::size_t ReferencePatternCache::size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return patterns_.size();
+    }
+
+    ReferencePatternCache &ReferencePatternCache::getDefault()
+    {
+        static ReferencePatternCache cache;
+        return cache;
+    }
+
+    const ReferencePattern *getDefaultReferencePattern(ReferenceShape shape, PointGenerationMethod method, int density)
+    {
+        // The default cache lives as long as the process and never evicts,
+        // so the remembered pointers stay valid
+        struct LastPattern
+        {
+            PointGenerationMethod method;
+            int density;
+            const ReferencePattern *pattern;
+        };
+        thread_local LastPattern last[2] = {};
+
+        LastPattern &slot = last[shape == ReferenceShape::QUAD ? 1 : 0];
+        if (slot.pattern && slot.method == method && slot.density == density)
+            return slot.pattern;
+
+        const ReferencePattern *pattern = ReferencePatternCache::getDefault().getPattern(shape, method, density);
+        if (pattern)
+            slot = LastPattern{method, density, pattern};
+        return pattern;
+    }
+
+    ReferencePatternSet::ReferencePatternSet(PointGenerationMethod method, int density)
+        : valid_(isReferencePatternMethod(method) && density >= 1)
+    {
+        if (!valid_)
+            return;
+
+        auto &cache = ReferencePatternCache::getDefault();
+        const ReferenceShape shapes[2] = {ReferenceShape::TRIANGLE, ReferenceShape::QUAD};
+        for (int s = 0; s < 2; ++s)
+        {
+            cached_[s] = cache.getPattern(shapes[s], method, density);
+            if (!cached_[s])
+                built_[s] = buildReferencePattern(shapes[s], method, density);
+        }
+    }
+
+    const ReferencePattern *ReferencePatternSet::get(ReferenceShape shape) const
+    {
+        if (!valid_)
+            return nullptr;
+
+        int s = (shape == ReferenceShape::QUAD) ? 1 : 0;
+        return cached_[s] ? cached_[s] : &built_[s];
+    }
+
+} // namespace czm_face
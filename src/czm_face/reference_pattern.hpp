@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <tuple>
+#include <vector>
+#include "czm_face.hpp"
+#include "quadrature.hpp"
+
+namespace czm_face
+{
+
+    // Layout of a point generation method in reference coordinates, shared by
+    // every face of one shape. With edgeParameters, point k lies at parameter
+    // xi[k] along face edge edge[k] and weighs measure[k] times the edge
+    // length; otherwise it lies at (xi[k], eta[k]) of CzmFace::mapReferencePoint
+    // and weighs measure[k] times the map Jacobian at (measureXi[k], measureEta[k]).
+    struct ReferencePattern
+    {
+        ReferenceShape shape = ReferenceShape::TRIANGLE;
+        PointGenerationMethod method = PointGenerationMethod::EDGE_ONLY;
+        int density = 0;             // Points per edge or quadrature order
+        bool edgeParameters = false; // Points given as (edge, parameter)
+        std::vector<double> xi;      // Reference coordinates
+        std::vector<double> eta;
+        std::vector<std::int8_t> edge;  // Edge index (-1 for interior points)
+        std::vector<double> measure;    // Reference weight
+        std::vector<double> measureXi;  // Where the Jacobian scales the weight
+        std::vector<double> measureEta;
+
+        // Get number of points
+        std::size_t size() const { return xi.size(); }
+
+        // Add a point
+        void add(double pointXi, double pointEta, int pointEdge, double weight, double weightXi, double weightEta);
+    };
+
+    // Check if the layout of a method is the same for every face of a shape
+    // (EDGE_ONLY, PARAMETRIC_GRID, GAUSS and LOBATTO). The other methods
+    // build their lattice over the face's bounding box.
+    bool isReferencePatternMethod(PointGenerationMethod method);
+
+    namespace detail
+    {
+        // Edge of a triangle lattice point (i, j), i + j <= last, or -1 inside.
+        // Edges lie on j = 0, i + j = last and i = 0; vertices belong to the
+        // edge starting at them.
+        inline int triangleLatticeEdge(int i, int j, int last)
+        {
+            if (j == 0 && i < last)
+                return 0;
+            if (i + j == last && j < last)
+                return 1;
+            if (i == 0)
+                return 2;
+            return -1;
+        }
+
+        // Edge of a quad lattice point (i, j) in [0, last]^2, or -1 inside.
+        // Edges lie on j = 0, i = last, j = last and i = 0.
+        inline int quadLatticeEdge(int i, int j, int last)
+        {
+            if (j == 0 && i < last)
+                return 0;
+            if (i == last && j < last)
+                return 1;
+            if (j == last && i > 0)
+                return 2;
+            if (i == 0 && j > 0)
+                return 3;
+            return -1;
+        }
+
+        // Number of lattice triangles touching point (i, j) of a triangle
+        // lattice i + j <= last. Lower triangles (a, b), (a + 1, b), (a, b + 1)
+        // and upper triangles (a + 1, b), (a + 1, b + 1), (a, b + 1) all have
+        // the same area.
+        inline int triangleLatticeValence(int i, int j, int last)
+        {
+            auto lower = [last](int a, int b)
+            { return a >= 0 && b >= 0 && a + b <= last - 1; };
+            auto upper = [last](int a, int b)
+            { return a >= 0 && b >= 0 && a + b <= last - 2; };
+            return lower(i, j) + lower(i - 1, j) + lower(i, j - 1) +
+                   upper(i - 1, j) + upper(i, j - 1) + upper(i - 1, j - 1);
+        }
+
+        // pointsPerEdge points on every edge, both end points included; each
+        // point carries half of each adjacent segment
+        template <typename Add>
+        void visitEdgePattern(int numEdges, int pointsPerEdge, Add &&add)
+        {
+            double segment = 1.0 / std::max(pointsPerEdge - 1, 1);
+            for (int e = 0; e < numEdges; ++e)
+            {
+                for (int i = 0; i < pointsPerEdge; ++i)
+                {
+                    double t = static_cast<double>(i) / (pointsPerEdge - 1);
+                    double weight = (i == 0 || i == pointsPerEdge - 1) ? 0.5 * segment : segment;
+                    add(t, 0.0, e, weight, 0.0, 0.0);
+                }
+            }
+        }
+
+        // Lattice with pointsPerEdge points per side. Boundary points are edge
+        // points of the edge they lie on, and each point weighs its dual cell.
+        template <typename Add>
+        void visitLatticePattern(ReferenceShape shape, int pointsPerEdge, Add &&add)
+        {
+            if (pointsPerEdge < 2)
+                return;
+
+            int last = pointsPerEdge - 1;
+            double step = 1.0 / last;
+            if (shape == ReferenceShape::TRIANGLE)
+            {
+                // Barycentric lattice i + j <= n - 1; a third of every lattice
+                // triangle touching the point (the Jacobian is constant)
+                for (int j = 0; j <= last; ++j)
+                {
+                    for (int i = 0; i <= last - j; ++i)
+                    {
+                        double weight = triangleLatticeValence(i, j, last) * step * step / 6.0;
+                        add(i * step, j * step, triangleLatticeEdge(i, j, last), weight, 0.0, 0.0);
+                    }
+                }
+                return;
+            }
+
+            // Bilinear lattice over the unit square; dual cells are clipped to
+            // the square, and the Jacobian of a planar face is linear, so its
+            // value at the cell center gives the exact mapped area
+            for (int j = 0; j <= last; ++j)
+            {
+                for (int i = 0; i <= last; ++i)
+                {
+                    double xi0 = std::max(0.0, (i - 0.5) * step), xi1 = std::min(1.0, (i + 0.5) * step);
+                    double eta0 = std::max(0.0, (j - 0.5) * step), eta1 = std::min(1.0, (j + 0.5) * step);
+                    add(i * step, j * step, quadLatticeEdge(i, j, last), (xi1 - xi0) * (eta1 - eta0),
+                        0.5 * (xi0 + xi1), 0.5 * (eta0 + eta1));
+                }
+            }
+        }
+
+        template <typename Add>
+        void visitQuadraturePattern(ReferenceShape shape, QuadratureFamily family, int order, Add &&add)
+        {
+            const ReferenceQuadrature *rule = getReferenceQuadrature(shape, family, order);
+            if (!rule)
+                return;
+
+            for (int k = 0; k < rule->numPoints; ++k)
+            {
+                add(rule->xi[k], rule->eta[k], rule->edge[k], rule->weights[k], rule->xi[k], rule->eta[k]);
+            }
+        }
+    }
+
+    // Call add(xi, eta, edge, weight, weightXi, weightEta) for every point of
+    // the pattern of a method, in order, without storing them (see
+    // ReferencePattern::add); generates the points of densities too large to
+    // cache. EDGE_ONLY points are given as (edge, parameter).
+    template <typename Add>
+    void visitReferencePatternPoints(ReferenceShape shape, PointGenerationMethod method, int density, Add &&add)
+    {
+        switch (method)
+        {
+        case PointGenerationMethod::EDGE_ONLY:
+            detail::visitEdgePattern((shape == ReferenceShape::QUAD) ? 4 : 3, density, add);
+            break;
+
+        case PointGenerationMethod::PARAMETRIC_GRID:
+            detail::visitLatticePattern(shape, density, add);
+            break;
+
+        case PointGenerationMethod::GAUSS:
+            detail::visitQuadraturePattern(shape, QuadratureFamily::GAUSS, density, add);
+            break;
+
+        case PointGenerationMethod::LOBATTO:
+            detail::visitQuadraturePattern(shape, QuadratureFamily::LOBATTO, density, add);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    // Build the pattern of a method; empty for unsupported densities and for
+    // methods that are not reference pattern methods
+    ReferencePattern buildReferencePattern(ReferenceShape shape, PointGenerationMethod method, int density);
+
+    // Thread-safe cache of reference patterns keyed by (shape, method,
+    // density). Patterns are built on first use and never evicted, so the
+    // returned pointers stay valid as long as the cache; lookups of cached
+    // patterns only take a shared lock. Densities below 1 or above
+    // kMaxCachedDensity are not cached, which bounds the cache at one pattern
+    // per shape, method and density up to that limit.
+    class ReferencePatternCache
+    {
+    public:
+        static constexpr int kMaxCachedDensity = 64;
+
+        ReferencePatternCache() = default;
+        ~ReferencePatternCache() = default;
+
+        // Prevent copying and moving (handed-out patterns point into the cache)
+        ReferencePatternCache(const ReferencePatternCache &) = delete;
+        ReferencePatternCache &operator=(const ReferencePatternCache &) = delete;
+        ReferencePatternCache(ReferencePatternCache &&) = delete;
+        ReferencePatternCache &operator=(ReferencePatternCache &&) = delete;
+
+        // Get the pattern of a method, or nullptr if it is not a reference
+        // pattern method or density is below 1 or above kMaxCachedDensity
+        const ReferencePattern *getPattern(ReferenceShape shape, PointGenerationMethod method, int density);
+
+        // Get number of cached patterns
+        std::size_t size() const;
+
+        // Get the process-wide cache used by the point generators
+        static ReferencePatternCache &getDefault();
+
+    private:
+        using Key = std::tuple<ReferenceShape, PointGenerationMethod, int>;
+
+        mutable std::shared_mutex mutex_;                                  // Guards patterns_
+        std::map<Key, std::unique_ptr<const ReferencePattern>> patterns_; // Cached patterns
+    };
+
+    // Get a pattern from the default cache, remembering the last pattern of
+    // each shape per thread so that per-face loops skip the lock and lookup
+    const ReferencePattern *getDefaultReferencePattern(ReferenceShape shape, PointGenerationMethod method, int density);
+
+    // Patterns of one method and density for both shapes, for generating the
+    // points of many faces: taken from the default cache, or built once and
+    // owned here for densities above ReferencePatternCache::kMaxCachedDensity
+    class ReferencePatternSet
+    {
+    public:
+        ReferencePatternSet() = default;
+        ReferencePatternSet(PointGenerationMethod method, int density);
+        ~ReferencePatternSet() = default;
+
+        // Allow copying
+        ReferencePatternSet(const ReferencePatternSet &) = default;
+        ReferencePatternSet &operator=(const ReferencePatternSet &) = default;
+
+        // Allow moving
+        ReferencePatternSet(ReferencePatternSet &&) = default;
+        ReferencePatternSet &operator=(ReferencePatternSet &&) = default;
+
+        // Get the pattern of a shape, or nullptr if the method is not a
+        // reference pattern method or the density is below 1
+        const ReferencePattern *get(ReferenceShape shape) const;
+
+    private:
+        bool valid_ = false;                      // Reference pattern method and density
+        const ReferencePattern *cached_[2] = {};  // Cached patterns (triangle, quad), or
+        ReferencePattern built_[2];               // patterns built for this set
+    };
+
+} // namespace czm_face
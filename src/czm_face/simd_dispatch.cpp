@@ -0,0 +1,64 @@
+#include "simd_dispatch.hpp"
+#include <atomic>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        std::atomic<int> &activeLevel()
+        {
+            static std::atomic<int> level(static_cast<int>(detectSimdLevel()));
+            return level;
+        }
+    }
+
+    SimdLevel detectSimdLevel()
+    {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+        static const SimdLevel detected = []
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+                return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2"))
+                return SimdLevel::AVX2;
+            return SimdLevel::SCALAR;
+        }();
+        return detected;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    SimdLevel getSimdLevel()
+    {
+        return static_cast<SimdLevel>(activeLevel().load(std::memory_order_relaxed));
+    }
+
+    SimdLevel setSimdLevel(SimdLevel level)
+    {
+        SimdLevel supported = detectSimdLevel();
+        if (static_cast<int>(level) > static_cast<int>(supported))
+        {
+            level = supported;
+        }
+        activeLevel().store(static_cast<int>(level), std::memory_order_relaxed);
+        return level;
+    }
+
+    const char *toString(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::AVX512:
+            return "avx512";
+        case SimdLevel::SCALAR:
+        default:
+            return "scalar";
+        }
+    }
+
+} // namespace czm_face
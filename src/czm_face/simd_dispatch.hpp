@@ -0,0 +1,28 @@
+#pragma once
+
+namespace czm_face
+{
+
+    // Instruction set used by the batch geometry kernels
+    enum class SimdLevel
+    {
+        SCALAR, // Portable scalar code
+        AVX2,   // 4 doubles per instruction (AVX2)
+        AVX512  // 8 doubles per instruction (AVX-512F)
+    };
+
+    // Detect the best instruction set supported by the running CPU
+    SimdLevel detectSimdLevel();
+
+    // Get the instruction set currently used by the batch kernels
+    SimdLevel getSimdLevel();
+
+    // Select the instruction set used by the batch kernels; requests for an
+    // unsupported level fall back to the best supported one. Returns the
+    // level actually selected.
+    SimdLevel setSimdLevel(SimdLevel level);
+
+    // Get a printable name of an instruction set
+    const char *toString(SimdLevel level);
+
+} // namespace czm_face
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace czm_face
+{
+
+    // Non-owning view of a contiguous sequence (C++17 stand-in for std::span)
+    template <typename T>
+    class Span
+    {
+    public:
+        using element_type = T;
+        using value_type = std::remove_cv_t<T>;
+        using iterator = T *;
+
+        constexpr Span() noexcept = default;
+        constexpr Span(T *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+        template <std::size_t N>
+        constexpr Span(T (&array)[N]) noexcept : data_(array), size_(N)
+        {
+        }
+
+        // View any contiguous container with data() and size() (std::vector, std::array, Span)
+        template <typename Container,
+                  typename = std::enable_if_t<!std::is_array<Container>::value &&
+                                              std::is_convertible<decltype(std::declval<Container &>().data()), T *>::value>>
+        constexpr Span(Container &container) noexcept : data_(container.data()), size_(container.size())
+        {
+        }
+
+        constexpr T *data() const noexcept { return data_; }
+        constexpr std::size_t size() const noexcept { return size_; }
+        constexpr bool empty() const noexcept { return size_ == 0; }
+
+        constexpr iterator begin() const noexcept { return data_; }
+        constexpr iterator end() const noexcept { return data_ + size_; }
+
+        constexpr T &operator[](std::size_t i) const noexcept { return data_[i]; }
+
+        // View of count elements starting at offset
+        constexpr Span subspan(std::size_t offset, std::size_t count) const noexcept
+        {
+            return Span(data_ + offset, count);
+        }
+
+    private:
+        T *data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+} // namespace czm_face
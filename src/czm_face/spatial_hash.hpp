@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace czm_face
+{
+
+    // Integer cell coordinates of a point quantized to a uniform grid
+    struct GridCell
+    {
+        std::int64_t x, y, z;
+    };
+
+    // Quantize a point to the grid cell containing it
+    inline GridCell quantizeToCell(double x, double y, double z, double inverseCellSize)
+    {
+        return GridCell{static_cast<std::int64_t>(std::floor(x * inverseCellSize)),
+                        static_cast<std::int64_t>(std::floor(y * inverseCellSize)),
+                        static_cast<std::int64_t>(std::floor(z * inverseCellSize))};
+    }
+
+    // Mix cell coordinates into a 64-bit key. Different cells may share a
+    // key, so users must verify candidates found through it.
+    inline std::uint64_t hashCell(std::int64_t x, std::int64_t y, std::int64_t z)
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(x) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<std::uint64_t>(y) * 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+        h ^= static_cast<std::uint64_t>(z) * 0x165667B19E3779F9ull + (h << 6) + (h >> 2);
+        return h;
+    }
+
+} // namespace czm_face
@@ -0,0 +1,136 @@
+#include "synthetic_mesh.hpp"
+#include "philox.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+        // Uniform value in [0, 1) from 32 random bits
+        double toUnit(std::uint32_t bits)
+        {
+            return bits * (1.0 / 4294967296.0);
+        }
+    }
+
+    SyntheticMesh::SyntheticMesh(const SyntheticMeshOptions &options)
+        : options_(options)
+    {
+        options_.perturbation = std::clamp(options.perturbation, 0.0, kMaxPerturbation);
+
+        bool triangles = options.kind == SyntheticMeshKind::PERTURBED_TRIANGLES ||
+                         options.kind == SyntheticMeshKind::SLIVER_TRIANGLES;
+        verticesPerFace_ = triangles ? 3 : 4;
+
+        // Near square lattice; triangle kinds put two faces in every cell
+        std::uint64_t cells = triangles ? (options.numFaces + 1) / 2 : options.numFaces;
+        columns_ = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::sqrt(static_cast<double>(cells)))));
+        cellWidth_ = options.spacing;
+        cellHeight_ = options.spacing;
+        if (options.kind == SyntheticMeshKind::SLIVER_TRIANGLES && options.aspectRatio > 0.0)
+            cellHeight_ = options.spacing / options.aspectRatio;
+
+        // Plane normal, either given or uniform on the sphere
+        normal_ = options.normal;
+        if (options.randomOrientation)
+        {
+            auto bits = Philox4x32::generate({0xFFFFFFFFu, 0xFFFFFFFFu, 0u, 0u},
+                                             {static_cast<std::uint32_t>(options.seed),
+                                              static_cast<std::uint32_t>(options.seed >> 32)});
+            double z = 2.0 * toUnit(bits[0]) - 1.0;
+            double phi = kTwoPi * toUnit(bits[1]);
+            double r = std::sqrt(std::max(0.0, 1.0 - z * z));
+            normal_ = Vec3D(r * std::cos(phi), r * std::sin(phi), z);
+        }
+        if (normal_.length() == 0.0)
+            normal_ = Vec3D(0, 0, 1);
+        normal_ = normal_ / normal_.length();
+
+        // Rows run along the coordinate axis least aligned with the normal,
+        // projected into the plane (x and y for the default z normal)
+        int axis = 0;
+        for (int k = 1; k < 3; ++k)
+        {
+            if (std::fabs(normal_.comp[k]) < std::fabs(normal_.comp[axis]))
+                axis = k;
+        }
+        Vec3D along(0, 0, 0);
+        along.comp[axis] = 1.0;
+        tangentU_ = along - normal_ * normal_.comp[axis];
+        tangentU_ = tangentU_ / tangentU_.length();
+        tangentV_ = normal_.cross(tangentU_);
+    }
+
+    Vec3D SyntheticMesh::getNode(std::uint64_t i, std::uint64_t j) const
+    {
+        double u = static_cast<double>(i) * cellWidth_;
+        double v = static_cast<double>(j) * cellHeight_;
+        switch (options_.kind)
+        {
+        case SyntheticMeshKind::PERTURBED_TRIANGLES:
+        {
+            auto bits = Philox4x32::generate({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i >> 32),
+                                              static_cast<std::uint32_t>(j), static_cast<std::uint32_t>(j >> 32)},
+                                             {static_cast<std::uint32_t>(options_.seed),
+                                              static_cast<std::uint32_t>(options_.seed >> 32)});
+            u += options_.perturbation * cellWidth_ * (2.0 * toUnit(bits[0]) - 1.0);
+            v += options_.perturbation * cellHeight_ * (2.0 * toUnit(bits[1]) - 1.0);
+            break;
+        }
+
+        case SyntheticMeshKind::SKEWED_QUADS:
+            u += options_.skew * v;
+            break;
+
+        default:
+            break;
+        }
+        return options_.origin + u * tangentU_ + v * tangentV_;
+    }
+
+    int SyntheticMesh::getFace(std::size_t face, Vec3D *vertices) const
+    {
+        std::uint64_t cell = (verticesPerFace_ == 3) ? face / 2 : face;
+        std::uint64_t i = cell % columns_;
+        std::uint64_t j = cell / columns_;
+        Vec3D corners[4] = {getNode(i, j), getNode(i + 1, j), getNode(i + 1, j + 1), getNode(i, j + 1)};
+
+        if (verticesPerFace_ == 4)
+        {
+            for (int k = 0; k < 4; ++k)
+                vertices[k] = corners[k];
+            return 4;
+        }
+
+        // Alternate the diagonal between neighbouring cells
+        static constexpr int kSplits[2][2][3] = {{{0, 1, 2}, {0, 2, 3}}, {{0, 1, 3}, {1, 2, 3}}};
+        const int *corner = kSplits[(i + j) % 2][face % 2];
+        for (int k = 0; k < 3; ++k)
+            vertices[k] = corners[corner[k]];
+        return 3;
+    }
+
+    void SyntheticMesh::appendTo(CzmFaceSet &faces) const
+    {
+        faces.reserve(faces.size() + size(), faces.getTotalVertices() + size() * verticesPerFace_);
+        visitFaces(0, size(), [&faces](const Vec3D *vertices, int count)
+                   { faces.addFace(vertices, count); });
+    }
+
+    std::vector<CzmFace> SyntheticMesh::createFaces(ThreadPool &pool) const
+    {
+        std::vector<CzmFace> faces(size());
+        pool.parallelFor(size(), 4096, [this, &faces](std::size_t begin, std::size_t end)
+                         {
+                             std::size_t face = begin;
+                             visitFaces(begin, end, [&faces, &face](const Vec3D *vertices, int count)
+                                        { faces[face++].createFace(vertices, count); });
+                         });
+        return faces;
+    }
+
+} // namespace czm_face
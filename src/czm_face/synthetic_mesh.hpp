@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "vec3d/vec3d.h"
+#include "czm_face.hpp"
+#include "czm_face_set.hpp"
+#include "thread_pool.hpp"
+
+namespace czm_face
+{
+
+    enum class SyntheticMeshKind
+    {
+        STRUCTURED_QUADS,    // Regular lattice of square cells
+        PERTURBED_TRIANGLES, // Lattice cells split in two, nodes randomly displaced
+        SKEWED_QUADS,        // Parallelogram cells, rows sheared by skew
+        SLIVER_TRIANGLES     // Cells flattened by aspectRatio and split in two
+    };
+
+    // Options of a synthetic mesh. The mesh lies in the plane through origin
+    // with the given normal (any orientation), so generators that assume
+    // faces in the XY plane can be tested on it.
+    struct SyntheticMeshOptions
+    {
+        SyntheticMeshKind kind = SyntheticMeshKind::STRUCTURED_QUADS; // Face layout
+        std::size_t numFaces = 1000;    // Number of faces
+        std::uint64_t seed = 0;         // Seed of node displacements and random orientation
+        double spacing = 1.0;           // Lattice spacing
+        double perturbation = 0.2;      // Node displacement as a fraction of spacing (see kMaxPerturbation)
+        double skew = 1.0;              // Row shear of SKEWED_QUADS per row height
+        double aspectRatio = 100.0;     // Cell width over height of SLIVER_TRIANGLES
+        Vec3D origin = Vec3D(0, 0, 0);  // Position of lattice node (0, 0)
+        Vec3D normal = Vec3D(0, 0, 1);  // Normal of the mesh plane
+        bool randomOrientation = false; // Draw the normal from the seed instead
+    };
+
+    // Reproducible synthetic interface mesh of any size (10^3 to 10^8 faces
+    // and beyond). Faces are computed on demand from their index: lattice
+    // nodes are displaced by a Philox draw keyed by (seed, node), so
+    // neighbouring faces share their vertices exactly, any face range can be
+    // produced independently, and no per-face vertex vectors are built.
+    class SyntheticMesh
+    {
+    public:
+        // Largest node displacement of PERTURBED_TRIANGLES; larger values are
+        // clamped. Displacing the corners of a lattice triangle by p cells in
+        // the worst directions leaves a doubled area of 1 - 4p cells, so at
+        // 0.25 faces can degenerate and above it they can invert.
+        static constexpr double kMaxPerturbation = 0.24;
+
+        explicit SyntheticMesh(const SyntheticMeshOptions &options);
+        ~SyntheticMesh() = default;
+
+        // Allow copying
+        SyntheticMesh(const SyntheticMesh &) = default;
+        SyntheticMesh &operator=(const SyntheticMesh &) = default;
+
+        // Allow moving
+        SyntheticMesh(SyntheticMesh &&) = default;
+        SyntheticMesh &operator=(SyntheticMesh &&) = default;
+
+        // Get number of faces
+        std::size_t size() const { return options_.numFaces; }
+
+        // Get number of vertices of every face (3 or 4)
+        int getVerticesPerFace() const { return verticesPerFace_; }
+
+        // Get unit normal of the mesh plane
+        const Vec3D &getNormal() const { return normal_; }
+
+        // Get the options the mesh was created with
+        const SyntheticMeshOptions &getOptions() const { return options_; }
+
+        // Write the counter-clockwise (about the normal) vertices of a face;
+        // returns the vertex count
+        int getFace(std::size_t face, Vec3D *vertices) const;
+
+        // Call sink(const Vec3D *vertices, int count) for faces [begin, end)
+        template <typename Sink>
+        void visitFaces(std::size_t begin, std::size_t end, Sink &&sink) const
+        {
+            Vec3D vertices[CzmFace::kMaxVertices];
+            for (std::size_t face = begin; face < end && face < size(); ++face)
+            {
+                int count = getFace(face, vertices);
+                sink(static_cast<const Vec3D *>(vertices), count);
+            }
+        }
+
+        // Append all faces to a face set
+        void appendTo(CzmFaceSet &faces) const;
+
+        // Create all faces, in parallel
+        std::vector<CzmFace> createFaces(ThreadPool &pool = ThreadPool::getDefault()) const;
+
+    private:
+        // Get the position of lattice node (i, j)
+        Vec3D getNode(std::uint64_t i, std::uint64_t j) const;
+
+        SyntheticMeshOptions options_; // Creation options
+        int verticesPerFace_ = 4;      // 3 for triangle kinds, 4 for quad kinds
+        std::uint64_t columns_ = 1;    // Cells per lattice row
+        double cellWidth_ = 1.0;       // Lattice spacing along the rows
+        double cellHeight_ = 1.0;      // Lattice spacing across the rows
+        Vec3D normal_;                 // Unit normal of the mesh plane
+        Vec3D tangentU_;               // In-plane axis along the rows
+        Vec3D tangentV_;               // In-plane axis across the rows
+    };
+
+} // namespace czm_face
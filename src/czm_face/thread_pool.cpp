@@ -0,0 +1,205 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <exception>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        // Pool and queue index of the current thread if it is a pool worker
+        thread_local const ThreadPool *tlsPool = nullptr;
+        thread_local int tlsWorker = -1;
+    }
+
+    ThreadPool::ThreadPool(unsigned numThreads)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        queues_.reserve(numThreads);
+        for (unsigned i = 0; i < numThreads; ++i)
+        {
+            queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        workers_.reserve(numThreads);
+        for (unsigned i = 0; i < numThreads; ++i)
+        {
+            workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        // Workers push to their own deque; external threads spread round robin
+        std::size_t index = (tlsPool == this)
+                                ? static_cast<std::size_t>(tlsWorker)
+                                : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            // Count before pushing so the counter never drops below the
+            // number of queued tasks, and under the sleep mutex so a worker
+            // cannot miss the wake-up
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            queued_.fetch_add(1, std::memory_order_release);
+        }
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        wake_.notify_one();
+    }
+
+    bool ThreadPool::tryPopTask(int ownIndex, std::function<void()> &task)
+    {
+        if (queued_.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+
+        // Newest task of the own deque first
+        if (ownIndex >= 0)
+        {
+            WorkerQueue &own = *queues_[ownIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        // Otherwise steal the oldest task of another deque
+        std::size_t numQueues = queues_.size();
+        std::size_t start = (ownIndex >= 0) ? static_cast<std::size_t>(ownIndex) + 1 : 0;
+        for (std::size_t k = 0; k < numQueues; ++k)
+        {
+            std::size_t index = (start + k) % numQueues;
+            if (static_cast<int>(index) == ownIndex)
+                continue;
+
+            WorkerQueue &victim = *queues_[index];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ThreadPool::runPendingTask()
+    {
+        std::function<void()> task;
+        int ownIndex = (tlsPool == this) ? tlsWorker : -1;
+        if (!tryPopTask(ownIndex, task))
+        {
+            return false;
+        }
+        task();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(unsigned index)
+    {
+        tlsPool = this;
+        tlsWorker = static_cast<int>(index);
+
+        for (;;)
+        {
+            std::function<void()> task;
+            if (tryPopTask(static_cast<int>(index), task))
+            {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this]
+                       { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+            if (stop_ && queued_.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    void ThreadPool::parallelFor(std::size_t count, std::size_t grainSize,
+                                 const std::function<void(std::size_t, std::size_t)> &body)
+    {
+        if (count == 0)
+            return;
+
+        grainSize = std::max<std::size_t>(grainSize, 1);
+        std::size_t numChunks = (count + grainSize - 1) / grainSize;
+        if (numChunks == 1)
+        {
+            body(0, count);
+            return;
+        }
+
+        std::atomic<std::size_t> remaining(numChunks);
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+        {
+            submit([&, chunk]
+                   {
+                       std::size_t begin = chunk * grainSize;
+                       std::size_t end = std::min(begin + grainSize, count);
+                       try
+                       {
+                           body(begin, end);
+                       }
+                       catch (...)
+                       {
+                           std::lock_guard<std::mutex> lock(errorMutex);
+                           if (!error)
+                               error = std::current_exception();
+                       }
+                       remaining.fetch_sub(1, std::memory_order_acq_rel); });
+        }
+
+        // Help with queued work until all chunks are done
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (!runPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    ThreadPool &ThreadPool::getDefault()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+} // namespace czm_face
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace czm_face
+{
+
+    // Work-stealing thread pool. Every worker owns a task deque: it pops its
+    // own tasks from the back (most recently pushed, cache-warm) and steals
+    // from the front of other workers' deques when it runs out of work.
+    class ThreadPool
+    {
+    public:
+        // Create a pool with numThreads workers (0 = hardware concurrency)
+        explicit ThreadPool(unsigned numThreads = 0);
+        ~ThreadPool();
+
+        // Prevent copying and moving (workers reference the pool)
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+        ThreadPool(ThreadPool &&) = delete;
+        ThreadPool &operator=(ThreadPool &&) = delete;
+
+        // Get number of worker threads
+        unsigned getNumThreads() const { return static_cast<unsigned>(workers_.size()); }
+
+        // Queue a task for asynchronous execution
+        void submit(std::function<void()> task);
+
+        // Run body(begin, end) over [0, count) in chunks of at most grainSize
+        // and wait for completion. The calling thread executes queued tasks
+        // while waiting, so nested calls from inside tasks do not deadlock.
+        // The first exception thrown by body is rethrown here.
+        void parallelFor(std::size_t count, std::size_t grainSize,
+                         const std::function<void(std::size_t, std::size_t)> &body);
+
+        // Get the process-wide pool shared by the batch APIs
+        static ThreadPool &getDefault();
+
+    private:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        // Worker thread main loop
+        void workerLoop(unsigned index);
+
+        // Pop a task from the own queue or steal one; false if none is queued
+        bool tryPopTask(int ownIndex, std::function<void()> &task);
+
+        // Run one queued task on the calling thread; false if none is queued
+        bool runPendingTask();
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues_; // One deque per worker
+        std::vector<std::thread> workers_;                 // Worker threads
+        std::mutex sleepMutex_;                            // Guards sleeping workers
+        std::condition_variable wake_;                     // Signals queued work or shutdown
+        std::atomic<std::size_t> queued_{0};               // Number of queued tasks
+        std::atomic<std::size_t> nextQueue_{0};            // Round robin for external submits
+        bool stop_ = false;                                // Shutdown flag (guarded by sleepMutex_)
+    };
+
+} // namespace czm_face
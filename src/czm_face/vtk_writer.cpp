@@ -0,0 +1,384 @@
+#include "vtk_writer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace czm_face
+{
+
+    namespace
+    {
+        constexpr std::uint8_t kVtkVertex = 1;
+        constexpr std::uint8_t kVtkTriangle = 5;
+        constexpr std::uint8_t kVtkQuad = 9;
+
+        bool isLittleEndian()
+        {
+            const std::uint32_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1;
+        }
+
+        // File output through a large buffer; values are stored in the byte
+        // order the format asks for, so arrays go out in bulk writes instead
+        // of per-value formatting
+        class BufferedWriter
+        {
+        public:
+            BufferedWriter(const std::string &path, bool bigEndian)
+                : file_(path, std::ios::binary | std::ios::trunc), buffer_(kBufferSize), swap_(bigEndian == isLittleEndian())
+            {
+            }
+
+            bool good() const { return static_cast<bool>(file_); }
+
+            void text(const std::string &value) { bytes(value.data(), value.size()); }
+
+            void bytes(const void *data, std::size_t size)
+            {
+                if (used_ + size > kBufferSize)
+                    flush();
+                if (size >= kBufferSize)
+                {
+                    file_.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+                    return;
+                }
+                std::memcpy(buffer_.data() + used_, data, size);
+                used_ += size;
+            }
+
+            template <typename T>
+            void value(T number)
+            {
+                char raw[sizeof(T)];
+                std::memcpy(raw, &number, sizeof(T));
+                if (swap_)
+                    std::reverse(raw, raw + sizeof(T));
+                bytes(raw, sizeof(T));
+            }
+
+            // Contiguous array, written as is when no byte swap is needed
+            template <typename T>
+            void array(const T *values, std::size_t count)
+            {
+                if (!swap_)
+                {
+                    bytes(values, count * sizeof(T));
+                    return;
+                }
+                for (std::size_t i = 0; i < count; ++i)
+                    value(values[i]);
+            }
+
+            // Array of count tuples of Components values, fill(T *tuple,
+            // std::size_t index) writing tuple index, called in index order;
+            // tuples are built in a contiguous block and each block goes out
+            // as one array
+            template <typename T, int Components = 1, typename Fill>
+            void generate(std::size_t count, Fill fill)
+            {
+                constexpr std::size_t kBlockTuples = 1024;
+                T block[kBlockTuples * Components];
+                for (std::size_t begin = 0; begin < count; begin += kBlockTuples)
+                {
+                    std::size_t end = std::min(count, begin + kBlockTuples);
+                    for (std::size_t i = begin; i < end; ++i)
+                        fill(block + (i - begin) * Components, i);
+                    array(block, (end - begin) * Components);
+                }
+            }
+
+            bool flush()
+            {
+                file_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+                used_ = 0;
+                return static_cast<bool>(file_.flush());
+            }
+
+        private:
+            static constexpr std::size_t kBufferSize = std::size_t(1) << 20;
+
+            std::ofstream file_;
+            std::vector<char> buffer_;
+            std::size_t used_ = 0;
+            bool swap_;
+        };
+
+        // Array of a VTK dataset, written by a callback
+        struct VtkArray
+        {
+            const char *name;      // Array name
+            const char *vtuType;   // XML type name
+            const char *vtkType;   // Legacy type name
+            int components;        // Components per tuple
+            std::size_t count;     // Number of tuples
+            std::size_t valueSize; // Bytes per component
+            std::function<void(BufferedWriter &)> write;
+        };
+
+        // Dataset with points, cells of one or two types and attribute arrays
+        struct VtkDataset
+        {
+            VtkArray points;
+            std::size_t numCells = 0;
+            VtkArray connectivity; // Point indices of all cells
+            VtkArray offsets;      // End of each cell in connectivity
+            VtkArray types;        // Cell types
+            bool vertexCells = false;
+            std::vector<VtkArray> pointData;
+            std::vector<VtkArray> cellData;
+        };
+
+        std::string vtuArrayTag(const VtkArray &array, std::uint64_t offset)
+        {
+            std::string tag = "<DataArray type=\"" + std::string(array.vtuType) + "\" Name=\"" + array.name + "\"";
+            if (array.components > 1)
+                tag += " NumberOfComponents=\"" + std::to_string(array.components) + "\"";
+            return tag + " format=\"appended\" offset=\"" + std::to_string(offset) + "\"/>\n";
+        }
+
+        bool writeVtu(const std::string &path, const VtkDataset &dataset)
+        {
+            // Appended blocks in file order, each a UInt64 byte count and the data
+            std::vector<const VtkArray *> blocks;
+            for (const auto &array : dataset.pointData)
+                blocks.push_back(&array);
+            for (const auto &array : dataset.cellData)
+                blocks.push_back(&array);
+            blocks.push_back(&dataset.points);
+            blocks.push_back(&dataset.connectivity);
+            blocks.push_back(&dataset.offsets);
+            blocks.push_back(&dataset.types);
+
+            std::vector<std::uint64_t> offsets;
+            std::uint64_t offset = 0;
+            for (const VtkArray *array : blocks)
+            {
+                offsets.push_back(offset);
+                offset += sizeof(std::uint64_t) + array->count * array->components * array->valueSize;
+            }
+
+            BufferedWriter writer(path, false);
+            if (!writer.good())
+                return false;
+
+            std::size_t block = 0;
+            writer.text("<?xml version=\"1.0\"?>\n"
+                        "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" "
+                        "header_type=\"UInt64\">\n"
+                        "  <UnstructuredGrid>\n");
+            writer.text("    <Piece NumberOfPoints=\"" + std::to_string(dataset.points.count) + "\" NumberOfCells=\"" +
+                        std::to_string(dataset.numCells) + "\">\n");
+            writer.text("      <PointData>\n");
+            for (const auto &array : dataset.pointData)
+                writer.text("        " + vtuArrayTag(array, offsets[block++]));
+            writer.text("      </PointData>\n      <CellData>\n");
+            for (const auto &array : dataset.cellData)
+                writer.text("        " + vtuArrayTag(array, offsets[block++]));
+            writer.text("      </CellData>\n      <Points>\n");
+            writer.text("        " + vtuArrayTag(dataset.points, offsets[block++]));
+            writer.text("      </Points>\n      <Cells>\n");
+            for (const VtkArray *array : {&dataset.connectivity, &dataset.offsets, &dataset.types})
+                writer.text("        " + vtuArrayTag(*array, offsets[block++]));
+            writer.text("      </Cells>\n    </Piece>\n  </UnstructuredGrid>\n"
+                        "  <AppendedData encoding=\"raw\">\n   _");
+            for (const VtkArray *array : blocks)
+            {
+                writer.value<std::uint64_t>(array->count * array->components * array->valueSize);
+                array->write(writer);
+            }
+            writer.text("\n  </AppendedData>\n</VTKFile>\n");
+            return writer.flush();
+        }
+
+        void writeLegacyArrays(BufferedWriter &writer, const std::vector<VtkArray> &arrays)
+        {
+            for (const auto &array : arrays)
+            {
+                writer.text("SCALARS " + std::string(array.name) + " " + array.vtkType + " " +
+                            std::to_string(array.components) + "\nLOOKUP_TABLE default\n");
+                array.write(writer);
+                writer.text("\n");
+            }
+        }
+
+        bool writeLegacy(const std::string &path, const VtkDataset &dataset)
+        {
+            // Cells are stored as (count, indices...) in 32-bit integers
+            std::size_t size = dataset.numCells + dataset.connectivity.count;
+            if (size > static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max()))
+                return false;
+
+            BufferedWriter writer(path, true);
+            if (!writer.good())
+                return false;
+
+            writer.text("# vtk DataFile Version 3.0\nczm_face\nBINARY\nDATASET POLYDATA\n");
+            writer.text("POINTS " + std::to_string(dataset.points.count) + " double\n");
+            dataset.points.write(writer);
+            writer.text(std::string("\n") + (dataset.vertexCells ? "VERTICES " : "POLYGONS ") +
+                        std::to_string(dataset.numCells) + " " + std::to_string(size) + "\n");
+            dataset.connectivity.write(writer);
+            writer.text("\n");
+
+            if (!dataset.cellData.empty())
+            {
+                writer.text("CELL_DATA " + std::to_string(dataset.numCells) + "\n");
+                writeLegacyArrays(writer, dataset.cellData);
+            }
+            if (!dataset.pointData.empty())
+            {
+                writer.text("POINT_DATA " + std::to_string(dataset.points.count) + "\n");
+                writeLegacyArrays(writer, dataset.pointData);
+            }
+            return writer.flush();
+        }
+
+        // Interleaved coordinates from x, y and z arrays
+        VtkArray makePoints(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &z)
+        {
+            return VtkArray{"Points", "Float64", "double", 3, x.size(), sizeof(double),
+                            [&x, &y, &z](BufferedWriter &writer)
+                            {
+                                writer.generate<double, 3>(x.size(), [&](double *xyz, std::size_t i)
+                                                           {
+                                                               xyz[0] = x[i];
+                                                               xyz[1] = y[i];
+                                                               xyz[2] = z[i]; });
+                            }};
+        }
+
+        bool writeDataset(const std::string &path, const VtkDataset &dataset, VtkFormat format)
+        {
+            return (format == VtkFormat::VTU) ? writeVtu(path, dataset) : writeLegacy(path, dataset);
+        }
+    }
+
+    bool writeVtkFaces(const std::string &path, const CzmFaceSet &faces, VtkFormat format)
+    {
+        const std::vector<std::size_t> &faceOffsets = faces.getOffsets();
+        std::size_t numFaces = faces.size();
+        bool legacy = format == VtkFormat::LEGACY_BINARY;
+
+        VtkDataset dataset;
+        dataset.points = makePoints(faces.getX(), faces.getY(), faces.getZ());
+        dataset.numCells = numFaces;
+
+        // Face vertices are stored consecutively, so cell k lists the
+        // vertices [offsets[k], offsets[k + 1]); the legacy format prefixes
+        // each cell with its size
+        dataset.connectivity = VtkArray{"connectivity", "Int64", "int", 1, faces.getTotalVertices(),
+                                        sizeof(std::int64_t),
+                                        [&faces, &faceOffsets, numFaces, legacy](BufferedWriter &writer)
+                                        {
+                                            if (!legacy)
+                                            {
+                                                writer.generate<std::int64_t>(faces.getTotalVertices(),
+                                                                              [](std::int64_t *index, std::size_t k)
+                                                                              { *index = static_cast<std::int64_t>(k); });
+                                                return;
+                                            }
+                                            // Values are filled in order: cell f starts at value
+                                            // faceOffsets[f] + f, and its vertices follow
+                                            std::size_t f = 0;
+                                            writer.generate<std::int32_t>(numFaces + faces.getTotalVertices(),
+                                                                          [&](std::int32_t *value, std::size_t i)
+                                                                          {
+                                                                              if (f < numFaces && i == faceOffsets[f] + f)
+                                                                              {
+                                                                                  *value = static_cast<std::int32_t>(faceOffsets[f + 1] - faceOffsets[f]);
+                                                                                  ++f;
+                                                                                  return;
+                                                                              }
+                                                                              *value = static_cast<std::int32_t>(i - f);
+                                                                          });
+                                        }};
+        dataset.offsets = VtkArray{"offsets", "Int64", "", 1, numFaces, sizeof(std::int64_t),
+                                   [&faceOffsets, numFaces](BufferedWriter &writer)
+                                   {
+                                       writer.generate<std::int64_t>(numFaces, [&](std::int64_t *offset, std::size_t f)
+                                                                     { *offset = static_cast<std::int64_t>(faceOffsets[f + 1]); });
+                                   }};
+        dataset.types = VtkArray{"types", "UInt8", "", 1, numFaces, sizeof(std::uint8_t),
+                                 [&faceOffsets, numFaces](BufferedWriter &writer)
+                                 {
+                                     writer.generate<std::uint8_t>(numFaces, [&](std::uint8_t *type, std::size_t f)
+                                                                   { *type = (faceOffsets[f + 1] - faceOffsets[f] == 4) ? kVtkQuad : kVtkTriangle; });
+                                 }};
+        dataset.cellData.push_back(VtkArray{"face_id", legacy ? "Int32" : "Int64", "int", 1, numFaces,
+                                            legacy ? sizeof(std::int32_t) : sizeof(std::int64_t),
+                                            [numFaces, legacy](BufferedWriter &writer)
+                                            {
+                                                if (legacy)
+                                                    writer.generate<std::int32_t>(numFaces, [](std::int32_t *id, std::size_t f)
+                                                                                  { *id = static_cast<std::int32_t>(f); });
+                                                else
+                                                    writer.generate<std::int64_t>(numFaces, [](std::int64_t *id, std::size_t f)
+                                                                                  { *id = static_cast<std::int64_t>(f); });
+                                            }});
+        return writeDataset(path, dataset, format);
+    }
+
+    bool writeVtkPoints(const std::string &path, const CzmPointCloud &points, Span<const double> weights,
+                        VtkFormat format)
+    {
+        std::size_t numPoints = points.size();
+        bool legacy = format == VtkFormat::LEGACY_BINARY;
+
+        VtkDataset dataset;
+        dataset.points = makePoints(points.getX(), points.getY(), points.getZ());
+        dataset.numCells = numPoints;
+        dataset.vertexCells = true;
+        dataset.connectivity = VtkArray{"connectivity", "Int64", "int", 1, numPoints, sizeof(std::int64_t),
+                                        [numPoints, legacy](BufferedWriter &writer)
+                                        {
+                                            if (legacy)
+                                                writer.generate<std::int32_t, 2>(numPoints, [](std::int32_t *cell, std::size_t i)
+                                                                                 {
+                                                                                     cell[0] = 1;
+                                                                                     cell[1] = static_cast<std::int32_t>(i); });
+                                            else
+                                                writer.generate<std::int64_t>(numPoints, [](std::int64_t *index, std::size_t i)
+                                                                              { *index = static_cast<std::int64_t>(i); });
+                                        }};
+        dataset.offsets = VtkArray{"offsets", "Int64", "", 1, numPoints, sizeof(std::int64_t),
+                                   [numPoints](BufferedWriter &writer)
+                                   {
+                                       writer.generate<std::int64_t>(numPoints, [](std::int64_t *offset, std::size_t i)
+                                                                     { *offset = static_cast<std::int64_t>(i + 1); });
+                                   }};
+        dataset.types = VtkArray{"types", "UInt8", "", 1, numPoints, sizeof(std::uint8_t),
+                                 [numPoints](BufferedWriter &writer)
+                                 {
+                                     writer.generate<std::uint8_t>(numPoints, [](std::uint8_t *type, std::size_t)
+                                                                   { *type = kVtkVertex; });
+                                 }};
+
+        dataset.pointData.push_back(VtkArray{"point_type", "UInt8", "unsigned_char", 1, numPoints, sizeof(std::uint8_t),
+                                             [&points, numPoints](BufferedWriter &writer)
+                                             {
+                                                 const std::vector<std::uint64_t> &bits = points.getTypeBits();
+                                                 writer.generate<std::uint8_t>(numPoints, [&bits](std::uint8_t *type, std::size_t i)
+                                                                               { *type = static_cast<std::uint8_t>((bits[i / 64] >> (i % 64)) & 1u); });
+                                             }});
+        dataset.pointData.push_back(VtkArray{"face_id", "UInt32", "unsigned_int", 1, numPoints, sizeof(std::uint32_t),
+                                             [&points, numPoints](BufferedWriter &writer)
+                                             { writer.array(points.getFaceIds().data(), numPoints); }});
+        dataset.pointData.push_back(VtkArray{"edge_index", "Int8", "char", 1, numPoints, sizeof(std::int8_t),
+                                             [&points, numPoints](BufferedWriter &writer)
+                                             { writer.array(points.getEdgeIndices().data(), numPoints); }});
+        if (weights.size() == numPoints && numPoints > 0)
+        {
+            dataset.pointData.push_back(VtkArray{"weight", "Float64", "double", 1, numPoints, sizeof(double),
+                                                 [weights](BufferedWriter &writer)
+                                                 { writer.array(weights.data(), weights.size()); }});
+        }
+        return writeDataset(path, dataset, format);
+    }
+
+} // namespace czm_face
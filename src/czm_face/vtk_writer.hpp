@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include "czm_face_set.hpp"
+#include "czm_point_cloud.hpp"
+#include "span.hpp"
+
+namespace czm_face
+{
+
+    enum class VtkFormat
+    {
+        VTU,          // XML unstructured grid with raw appended binary data
+        LEGACY_BINARY // Legacy VTK polydata with big-endian binary arrays
+    };
+
+    // Write faces as triangle and quad cells, with a face_id cell array.
+    // Vertices are written per face as stored in the set (shared vertices are
+    // not merged). Returns false on I/O errors, and for the legacy format
+    // also if the data exceeds its 32-bit indices.
+    bool writeVtkFaces(const std::string &path, const CzmFaceSet &faces, VtkFormat format = VtkFormat::VTU);
+
+    // Write points as vertex cells with point_type (0 interior, 1 edge),
+    // face_id and edge_index point arrays, and a weight array if weights
+    // holds one value per point. Same errors as writeVtkFaces.
+    bool writeVtkPoints(const std::string &path, const CzmPointCloud &points, Span<const double> weights = {},
+                        VtkFormat format = VtkFormat::VTU);
+
+} // namespace czm_face
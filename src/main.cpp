@@ -45,8 +45,8 @@ void testCzmFace()
                       << std::setw(6) << pos.comp[2] << ") - ";
             if (point.getType() == czm_face::PointType::EDGE_POINT)
             {
-                const auto *edge = point.getEdge();
-                std::cout << "Edge point (edge length: " << edge->length() << ")";
+                czm_face::Edge edge = triangleFace.getEdge(point.getEdgeIndex());
+                std::cout << "Edge point (edge length: " << edge.length() << ")";
             }
             else
             {
@@ -110,8 +110,8 @@ void testCzmFace()
                       << std::setw(6) << pos.comp[2] << ") - ";
             if (point.getType() == czm_face::PointType::EDGE_POINT)
             {
-                const auto *edge = point.getEdge();
-                std::cout << "Edge point (edge length: " << edge->length() << ")";
+                czm_face::Edge edge = quadFace.getEdge(point.getEdgeIndex());
+                std::cout << "Edge point (edge length: " << edge.length() << ")";
             }
             else
             {
@@ -160,8 +160,8 @@ void testPointGeneration()
                       << std::setw(6) << pos.comp[2] << ") - ";
             if (point.getType() == czm_face::PointType::EDGE_POINT)
             {
-                const auto *edge = point.getEdge();
-                std::cout << "Edge point (edge length: " << edge->length() << ")";
+                czm_face::Edge edge = squareFace.getEdge(point.getEdgeIndex());
+                std::cout << "Edge point (edge length: " << edge.length() << ")";
             }
             else
             {
@@ -184,8 +184,8 @@ void testPointGeneration()
                       << std::setw(6) << pos.comp[2] << ") - ";
             if (point.getType() == czm_face::PointType::EDGE_POINT)
             {
-                const auto *edge = point.getEdge();
-                std::cout << "Edge point (edge length: " << edge->length() << ")";
+                czm_face::Edge edge = squareFace.getEdge(point.getEdgeIndex());
+                std::cout << "Edge point (edge length: " << edge.length() << ")";
             }
             else
             {
@@ -208,8 +208,8 @@ void testPointGeneration()
                       << std::setw(6) << pos.comp[2] << ") - ";
             if (point.getType() == czm_face::PointType::EDGE_POINT)
             {
-                const auto *edge = point.getEdge();
-                std::cout << "Edge point (edge length: " << edge->length() << ")";
+                czm_face::Edge edge = squareFace.getEdge(point.getEdgeIndex());
+                std::cout << "Edge point (edge length: " << edge.length() << ")";
             }
             else
             {
@@ -232,8 +232,8 @@ void testPointGeneration()
                       << std::setw(6) << pos.comp[2] << ") - ";
             if (point.getType() == czm_face::PointType::EDGE_POINT)
             {
-                const auto *edge = point.getEdge();
-                std::cout << "Edge point (edge length: " << edge->length() << ")";
+                czm_face::Edge edge = squareFace.getEdge(point.getEdgeIndex());
+                std::cout << "Edge point (edge length: " << edge.length() << ")";
             }
             else
             {
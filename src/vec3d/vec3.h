@@ -0,0 +1,223 @@
+#ifndef VEC3_H
+#define VEC3_H
+
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+// Header-only 3D vector. All operators are inline, const-correct and
+// constexpr where the standard library allows it, so geometry code using
+// them can be inlined and vectorized without link-time optimization.
+template <typename T>
+class Vec3
+{
+public:
+    using value_type = T;
+
+    T comp[3];
+
+    constexpr Vec3(T x = T(0), T y = T(0), T z = T(0)) noexcept : comp{x, y, z} {}
+
+    // Convert between precisions
+    template <typename U>
+    constexpr explicit Vec3(const Vec3<U> &other) noexcept
+        : comp{static_cast<T>(other.comp[0]), static_cast<T>(other.comp[1]), static_cast<T>(other.comp[2])}
+    {
+    }
+
+    constexpr Vec3(const Vec3 &) noexcept = default;
+    constexpr Vec3 &operator=(const Vec3 &) noexcept = default;
+
+    constexpr T dot(const Vec3 &right) const noexcept
+    {
+        return comp[0] * right.comp[0] + comp[1] * right.comp[1] + comp[2] * right.comp[2];
+    }
+
+    constexpr Vec3 cross(const Vec3 &right) const noexcept
+    {
+        return Vec3(comp[1] * right.comp[2] - comp[2] * right.comp[1],
+                    -comp[0] * right.comp[2] + comp[2] * right.comp[0],
+                    comp[0] * right.comp[1] - comp[1] * right.comp[0]);
+    }
+
+    constexpr T squaredLength() const noexcept { return dot(*this); }
+
+    T length() const noexcept { return std::sqrt(squaredLength()); }
+
+    // Unit vector in the same direction
+    Vec3 norm() const noexcept
+    {
+        T magnitude = length();
+        return Vec3(comp[0] / magnitude, comp[1] / magnitude, comp[2] / magnitude);
+    }
+
+    constexpr Vec3 &operator=(const T &right) noexcept
+    {
+        comp[0] = right;
+        comp[1] = right;
+        comp[2] = right;
+        return *this;
+    }
+
+    Vec3 &operator=(const std::vector<T> &right)
+    {
+        comp[0] = right[0];
+        comp[1] = right[1];
+        comp[2] = right[2];
+        return *this;
+    }
+
+    constexpr Vec3 &operator*=(const T &right) noexcept
+    {
+        comp[0] *= right;
+        comp[1] *= right;
+        comp[2] *= right;
+        return *this;
+    }
+
+    constexpr Vec3 &operator/=(const T &right) noexcept
+    {
+        comp[0] /= right;
+        comp[1] /= right;
+        comp[2] /= right;
+        return *this;
+    }
+
+    constexpr Vec3 &operator+=(const T &right) noexcept
+    {
+        comp[0] += right;
+        comp[1] += right;
+        comp[2] += right;
+        return *this;
+    }
+
+    constexpr Vec3 &operator+=(const Vec3 &right) noexcept
+    {
+        comp[0] += right.comp[0];
+        comp[1] += right.comp[1];
+        comp[2] += right.comp[2];
+        return *this;
+    }
+
+    constexpr Vec3 &operator-=(const T &right) noexcept
+    {
+        comp[0] -= right;
+        comp[1] -= right;
+        comp[2] -= right;
+        return *this;
+    }
+
+    constexpr Vec3 &operator-=(const Vec3 &right) noexcept
+    {
+        comp[0] -= right.comp[0];
+        comp[1] -= right.comp[1];
+        comp[2] -= right.comp[2];
+        return *this;
+    }
+
+    constexpr Vec3 operator-() const noexcept { return Vec3(-comp[0], -comp[1], -comp[2]); }
+
+    constexpr bool operator==(const Vec3 &right) const noexcept
+    {
+        return comp[0] == right.comp[0] && comp[1] == right.comp[1] && comp[2] == right.comp[2];
+    }
+
+    constexpr bool operator!=(const Vec3 &right) const noexcept { return !(*this == right); }
+
+    constexpr T &operator[](int i) noexcept { return comp[i]; }
+    constexpr const T &operator[](int i) const noexcept { return comp[i]; }
+};
+
+// Scalar operands are taken as Vec3<T>::value_type so that mixed literals
+// such as v * 2 or 0.5f * v convert instead of failing template deduction.
+
+template <typename T>
+constexpr Vec3<T> operator+(const Vec3<T> &left, const Vec3<T> &right) noexcept
+{
+    return Vec3<T>(left.comp[0] + right.comp[0], left.comp[1] + right.comp[1], left.comp[2] + right.comp[2]);
+}
+
+template <typename T>
+constexpr Vec3<T> operator-(const Vec3<T> &left, const Vec3<T> &right) noexcept
+{
+    return Vec3<T>(left.comp[0] - right.comp[0], left.comp[1] - right.comp[1], left.comp[2] - right.comp[2]);
+}
+
+template <typename T>
+constexpr Vec3<T> operator*(const Vec3<T> &left, const typename Vec3<T>::value_type &right) noexcept
+{
+    return Vec3<T>(left.comp[0] * right, left.comp[1] * right, left.comp[2] * right);
+}
+
+template <typename T>
+constexpr Vec3<T> operator*(const typename Vec3<T>::value_type &left, const Vec3<T> &right) noexcept
+{
+    return Vec3<T>(left * right.comp[0], left * right.comp[1], left * right.comp[2]);
+}
+
+template <typename T>
+constexpr Vec3<T> operator/(const Vec3<T> &left, const typename Vec3<T>::value_type &right) noexcept
+{
+    return Vec3<T>(left.comp[0] / right, left.comp[1] / right, left.comp[2] / right);
+}
+
+template <typename T>
+constexpr Vec3<T> operator/(const typename Vec3<T>::value_type &left, const Vec3<T> &right) noexcept
+{
+    return Vec3<T>(left / right.comp[0], left / right.comp[1], left / right.comp[2]);
+}
+
+template <typename T>
+constexpr Vec3<T> operator+(const Vec3<T> &left, const typename Vec3<T>::value_type &right) noexcept
+{
+    return Vec3<T>(left.comp[0] + right, left.comp[1] + right, left.comp[2] + right);
+}
+
+template <typename T>
+constexpr Vec3<T> operator+(const typename Vec3<T>::value_type &left, const Vec3<T> &right) noexcept
+{
+    return Vec3<T>(left + right.comp[0], left + right.comp[1], left + right.comp[2]);
+}
+
+template <typename T>
+constexpr Vec3<T> operator-(const Vec3<T> &left, const typename Vec3<T>::value_type &right) noexcept
+{
+    return Vec3<T>(left.comp[0] - right, left.comp[1] - right, left.comp[2] - right);
+}
+
+template <typename T>
+constexpr Vec3<T> operator-(const typename Vec3<T>::value_type &left, const Vec3<T> &right) noexcept
+{
+    return Vec3<T>(left - right.comp[0], left - right.comp[1], left - right.comp[2]);
+}
+
+template <typename T>
+constexpr T dot(const Vec3<T> &left, const Vec3<T> &right) noexcept
+{
+    return left.dot(right);
+}
+
+template <typename T>
+constexpr Vec3<T> cross(const Vec3<T> &left, const Vec3<T> &right) noexcept
+{
+    return left.cross(right);
+}
+
+// Vector magnitude
+template <typename T>
+inline T fabs(const Vec3<T> &vec) noexcept
+{
+    return vec.length();
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &output, const Vec3<T> &right)
+{
+    output << "[" << right.comp[0] << "," << right.comp[1] << "," << right.comp[2] << "]";
+    return output;
+}
+
+using Vec3d = Vec3<double>;
+using Vec3f = Vec3<float>;
+
+#endif
@@ -25,43 +25,12 @@
 
 #include <iostream>
 #include <vector>
+#include "vec3.h"
 using namespace std;
 
-class Vec3D {
-public:
-	double comp[3];
-	Vec3D(double x=0., double y=0., double z=0.);
-	double dot(const Vec3D &right);
-	Vec3D cross(const Vec3D &right);
-	Vec3D norm(void);
-	Vec3D &operator= (const Vec3D &);
-	Vec3D &operator= (const double &);
-	Vec3D &operator= (const std::vector<double> &);
-	Vec3D &operator*= (const double &);
-	Vec3D operator*(const double &);
-	Vec3D &operator/= (const double &);
-	Vec3D operator/ (const double &);
-	Vec3D &operator+= (const double &);
-	Vec3D &operator+= (const Vec3D &);
-	Vec3D operator+ (const double &);
-	Vec3D &operator-= (const double &);
-	Vec3D &operator-= (const Vec3D &);
-	Vec3D operator- (const double &);
-	Vec3D operator-() const;
-	bool operator== (const Vec3D &);
-	bool operator!= (const Vec3D &);
-	double &operator[] (int i); 
-};
-
-double fabs(const Vec3D vec);
-Vec3D operator*(const double &left, const Vec3D &right);
-Vec3D operator/ (const double &left, const Vec3D &right);
-Vec3D operator+ (const double &left, const Vec3D &right);
-Vec3D operator- (const double &left, const Vec3D &right);
-
-Vec3D operator+ (const Vec3D &left, const Vec3D &right);
-Vec3D operator- (const Vec3D &left, const Vec3D &right);
-
-ostream &operator<< (ostream &output,const Vec3D &right);
+// Compatibility name for the double precision Vec3. The former out-of-line
+// class had the same members (comp[], dot, cross, norm, operator[]) and the
+// same free operators; they are now inline and const-correct.
+typedef Vec3<double> Vec3D;
 
 #endif
@@ -0,0 +1,1451 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include "czm_face/binary_format.hpp"
+#include "czm_face/centroidal_layout.hpp"
+#include "czm_face/czm_face.hpp"
+#include "czm_face/czm_face_set.hpp"
+#include "czm_face/czm_face_pairer.hpp"
+#include "czm_face/face_bvh.hpp"
+#include "czm_face/face_topology.hpp"
+#include "czm_face/reference_pattern.hpp"
+#include "czm_face/synthetic_mesh.hpp"
+#include "czm_face/vtk_writer.hpp"
+#include "czm_face/face_inside_tester.hpp"
+#include "czm_face/point_generation_engine.hpp"
+#include "czm_face/point_stream.hpp"
+#include "czm_face/simd_dispatch.hpp"
+
+namespace
+{
+    const std::vector<Vec3D> kTriangle = {
+        Vec3D(0, 0, 0),
+        Vec3D(2, 0, 0),
+        Vec3D(0, 1, 1)};
+
+    const std::vector<Vec3D> kQuad = {
+        Vec3D(1, 1, 0),
+        Vec3D(0, 0, 0),
+        Vec3D(0, 1, 0),
+        Vec3D(1, 0, 0)};
+}
+
+TEST(CzmFaceTest, InlineStorageIsMemcpyable)
+{
+    czm_face::CzmFace quad;
+    ASSERT_TRUE(quad.createFace(kQuad));
+    EXPECT_EQ(quad.getNumVertices(), 4);
+    EXPECT_EQ(quad.getNumEdges(), 4);
+
+    // Edges are vertex index pairs closing the loop
+    for (int e = 0; e < quad.getNumEdges(); ++e)
+    {
+        EXPECT_EQ(quad.getEdgeIndices(e).start, e);
+        EXPECT_EQ(quad.getEdgeIndices(e).end, (e + 1) % 4);
+    }
+
+    czm_face::CzmFace copy;
+    std::memcpy(static_cast<void *>(&copy), &quad, sizeof(czm_face::CzmFace));
+    EXPECT_DOUBLE_EQ(copy.calculateArea(), 1.0);
+    EXPECT_DOUBLE_EQ(copy.calculatePerimeter(), 4.0);
+    EXPECT_EQ(copy.generatePointGrid(5).size(), quad.generatePointGrid(5).size());
+
+    // Edge points reference edges by index, so they stay valid for copies
+    auto points = copy.generatePointGrid(3, czm_face::PointGenerationMethod::EDGE_ONLY);
+    ASSERT_EQ(points.size(), 12u);
+    EXPECT_EQ(points[4].getEdgeIndex(), 1);
+    EXPECT_DOUBLE_EQ(copy.getEdge(points[4].getEdgeIndex()).length(), 1.0);
+}
+
+TEST(CzmFaceSetTest, RejectsInvalidVertexCount)
+{
+    czm_face::CzmFaceSet faces;
+    EXPECT_FALSE(faces.addFace({Vec3D(0, 0, 0), Vec3D(1, 0, 0)}));
+    EXPECT_TRUE(faces.empty());
+}
+
+TEST(CzmFaceSetTest, MatchesCzmFaceGeometry)
+{
+    czm_face::CzmFaceSet faces;
+    ASSERT_TRUE(faces.addFace(kTriangle));
+    ASSERT_TRUE(faces.addFace(kQuad));
+    ASSERT_EQ(faces.size(), 2u);
+    EXPECT_EQ(faces.getTotalVertices(), 7u);
+
+    auto areas = faces.calculateAreas();
+    auto centers = faces.calculateCenters();
+    auto perimeters = faces.calculatePerimeters();
+    auto normals = faces.calculateNormals();
+
+    for (std::size_t f = 0; f < faces.size(); ++f)
+    {
+        czm_face::CzmFace face;
+        ASSERT_TRUE(face.createFace(f == 0 ? kTriangle : kQuad));
+        EXPECT_EQ(faces.getFace(f).getNumVertices(), face.getNumVertices());
+
+        EXPECT_NEAR(areas[f], face.calculateArea(), 1e-12);
+        EXPECT_NEAR(perimeters[f], face.calculatePerimeter(), 1e-12);
+        Vec3D center = face.calculateCenter();
+        Vec3D normal = face.getNormal();
+        for (int c = 0; c < 3; ++c)
+        {
+            EXPECT_NEAR(centers[f].comp[c], center.comp[c], 1e-12);
+            EXPECT_NEAR(normals[f].comp[c], normal.comp[c], 1e-12);
+        }
+        for (std::size_t v = 0; v < faces.getNumVertices(f); ++v)
+        {
+            Vec3D vertex = faces.getVertex(f, v);
+            EXPECT_TRUE(vertex == face.getVertices()[v]);
+        }
+    }
+}
+
+TEST(FaceKernelsTest, SimdLevelsAgreeWithScalar)
+{
+    // Mixed triangles and quads so every SIMD block contains both shapes
+    czm_face::CzmFaceSet faces;
+    for (int i = 0; i < 37; ++i)
+    {
+        double s = 0.5 + 0.1 * i;
+        Vec3D shift(i, 0.3 * i, -0.2 * i);
+        if (i % 3 == 0)
+        {
+            faces.addFace({s * kTriangle[0] + shift, s * kTriangle[1] + shift, s * kTriangle[2] + shift});
+        }
+        else
+        {
+            faces.addFace({s * kQuad[0] + shift, s * kQuad[1] + shift, s * kQuad[2] + shift, s * kQuad[3] + shift});
+        }
+    }
+    faces.addFace({Vec3D(0, 0, 0), Vec3D(1, 1, 1), Vec3D(2, 2, 2)}); // degenerate
+
+    czm_face::SimdLevel original = czm_face::getSimdLevel();
+    czm_face::setSimdLevel(czm_face::SimdLevel::SCALAR);
+    auto areas = faces.calculateAreas();
+    auto centers = faces.calculateCenters();
+    auto normals = faces.calculateNormals();
+
+    for (auto level : {czm_face::SimdLevel::AVX2, czm_face::SimdLevel::AVX512})
+    {
+        czm_face::setSimdLevel(level);
+        auto simdAreas = faces.calculateAreas();
+        auto simdCenters = faces.calculateCenters();
+        auto simdNormals = faces.calculateNormals();
+        for (std::size_t f = 0; f < faces.size(); ++f)
+        {
+            EXPECT_NEAR(simdAreas[f], areas[f], 1e-12);
+            for (int c = 0; c < 3; ++c)
+            {
+                EXPECT_NEAR(simdCenters[f].comp[c], centers[f].comp[c], 1e-12);
+                EXPECT_NEAR(simdNormals[f].comp[c], normals[f].comp[c], 1e-12);
+            }
+        }
+    }
+    czm_face::setSimdLevel(original);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversRangeAndNests)
+{
+    czm_face::ThreadPool pool(3);
+    std::vector<int> hits(1000, 0);
+    std::atomic<int> inner(0);
+    pool.parallelFor(hits.size(), 7, [&](std::size_t begin, std::size_t end)
+                     {
+                         for (std::size_t i = begin; i < end; ++i)
+                             ++hits[i];
+                         pool.parallelFor(4, 1, [&](std::size_t b, std::size_t e)
+                                          { inner += static_cast<int>(e - b); }); });
+
+    for (int h : hits)
+        EXPECT_EQ(h, 1);
+    EXPECT_EQ(inner.load(), 4 * 143);
+
+    EXPECT_THROW(pool.parallelFor(10, 1, [](std::size_t begin, std::size_t)
+                                  { if (begin == 5) throw std::runtime_error("fail"); }),
+                 std::runtime_error);
+}
+
+TEST(PointGenerationEngineTest, MatchesPerFaceGeneration)
+{
+    std::vector<czm_face::CzmFace> faces(50);
+    for (std::size_t i = 0; i < faces.size(); ++i)
+    {
+        double s = 1.0 + 0.05 * i;
+        if (i % 2 == 0)
+            faces[i].createFace({s * kTriangle[0], s * kTriangle[1], s * kTriangle[2]});
+        else
+            faces[i].createFace({s * kQuad[0], s * kQuad[1], s * kQuad[2], s * kQuad[3]});
+    }
+
+    czm_face::ThreadPool pool(4);
+    for (auto method : {czm_face::PointGenerationMethod::EDGE_ONLY,
+                        czm_face::PointGenerationMethod::EDGE_AND_INTERIOR,
+                        czm_face::PointGenerationMethod::INTERIOR_ONLY,
+                        czm_face::PointGenerationMethod::UNIFORM_GRID})
+    {
+        auto result = czm_face::generatePointsForFaces(faces, method, 6, pool);
+        ASSERT_EQ(result.getNumFaces(), faces.size());
+        for (std::size_t f = 0; f < faces.size(); ++f)
+        {
+            auto expected = faces[f].generatePointGrid(6, method);
+            auto actual = result.getFacePoints(f);
+            ASSERT_EQ(actual.size(), expected.size());
+            EXPECT_EQ(faces[f].countPoints(6, method), expected.size());
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                EXPECT_TRUE(actual[i].getPosition() == expected[i].getPosition());
+                EXPECT_EQ(actual[i].getEdgeIndex(), expected[i].getEdgeIndex());
+            }
+        }
+    }
+}
+
+TEST(CzmFaceTest, BufferOverloadsReuseCallerStorage)
+{
+    czm_face::CzmFace square;
+    ASSERT_TRUE(square.createFace({Vec3D(0, 0, 0), Vec3D(1, 0, 0), Vec3D(1, 1, 0), Vec3D(0, 1, 0)}));
+
+    std::vector<czm_face::CZM_Point> buffer(64);
+    for (auto method : {czm_face::PointGenerationMethod::EDGE_ONLY,
+                        czm_face::PointGenerationMethod::EDGE_AND_INTERIOR,
+                        czm_face::PointGenerationMethod::INTERIOR_ONLY,
+                        czm_face::PointGenerationMethod::UNIFORM_GRID})
+    {
+        auto expected = square.generatePointGrid(5, method);
+        std::size_t count = square.generatePointGrid(5, method, buffer);
+        ASSERT_EQ(count, expected.size());
+        ASSERT_EQ(square.countPoints(5, method), expected.size());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EXPECT_TRUE(buffer[i].getPosition() == expected[i].getPosition());
+        }
+    }
+
+    // A short buffer is filled up to its size and the full count is reported
+    czm_face::Span<czm_face::CZM_Point> shortBuffer(buffer.data(), 3);
+    EXPECT_EQ(square.generatePointGrid(5, czm_face::PointGenerationMethod::EDGE_ONLY, shortBuffer), 20u);
+
+    // Equal area selection never exceeds the requested count
+    std::size_t numEqualArea = square.countEqualAreaPoints(10);
+    EXPECT_GT(numEqualArea, 0u);
+    EXPECT_LE(numEqualArea, 10u);
+    EXPECT_EQ(square.generateEqualAreaPoints(10, buffer), numEqualArea);
+    EXPECT_EQ(square.generateEqualAreaPoints(10).size(), numEqualArea);
+    for (std::size_t i = 0; i < numEqualArea; ++i)
+    {
+        EXPECT_EQ(buffer[i].getType(), czm_face::PointType::INTERIOR_POINT);
+    }
+}
+
+TEST(PointGenerationEngineTest, EqualAreaCountsPerFace)
+{
+    std::vector<czm_face::CzmFace> faces(20);
+    for (auto &face : faces)
+        face.createFace(kQuad);
+
+    czm_face::ThreadPool pool(2);
+    auto result = czm_face::generateEqualAreaPointsForFaces(faces, 9, pool);
+    ASSERT_EQ(result.getNumFaces(), faces.size());
+    for (std::size_t f = 0; f < faces.size(); ++f)
+    {
+        EXPECT_EQ(result.getFacePoints(f).size(), faces[f].countEqualAreaPoints(9));
+    }
+}
+
+TEST(CzmPointCloudTest, RoundTripsPoints)
+{
+    std::vector<czm_face::CzmFace> faces(2);
+    ASSERT_TRUE(faces[0].createFace(kTriangle));
+    ASSERT_TRUE(faces[1].createFace(kQuad));
+
+    auto pointSet = czm_face::generatePointsForFaces(faces, czm_face::PointGenerationMethod::EDGE_AND_INTERIOR, 4);
+    czm_face::CzmPointCloud cloud = czm_face::toPointCloud(pointSet);
+    ASSERT_EQ(cloud.size(), pointSet.points.size());
+    EXPECT_EQ(cloud.getTypeBits().size(), (cloud.size() + 63) / 64);
+
+    std::vector<czm_face::CZM_Point> points = cloud.toPoints();
+    for (std::size_t f = 0; f < pointSet.getNumFaces(); ++f)
+    {
+        for (std::size_t i = pointSet.offsets[f]; i < pointSet.offsets[f + 1]; ++i)
+        {
+            const auto &expected = pointSet.points[i];
+            EXPECT_EQ(cloud.getFaceId(i), f);
+            EXPECT_EQ(points[i].getPosition(), expected.getPosition());
+            EXPECT_EQ(points[i].getType(), expected.getType());
+            EXPECT_EQ(points[i].getEdgeIndex(), expected.getEdgeIndex());
+        }
+    }
+}
+
+TEST(BinaryFormatTest, RoundTripsFaceSetsAndPointClouds)
+{
+    // Mixed triangles and quads
+    czm_face::CzmFaceSet faces;
+    ASSERT_TRUE(faces.addFace(kTriangle));
+    ASSERT_TRUE(faces.addFace(kQuad));
+    czm_face::SyntheticMeshOptions options;
+    options.kind = czm_face::SyntheticMeshKind::PERTURBED_TRIANGLES;
+    options.numFaces = 333;
+    czm_face::SyntheticMesh(options).appendTo(faces);
+
+    std::string facePath = ::testing::TempDir() + "czm_faces.bin";
+    ASSERT_TRUE(czm_face::writeFaceSet(facePath, faces));
+
+    // Mapped arrays are aligned and used in place by the batch kernels
+    czm_face::BinaryFile file;
+    ASSERT_TRUE(file.open(facePath));
+    ASSERT_EQ(file.getContents(), czm_face::BinaryContents::FACE_SET);
+    ASSERT_EQ(file.size(), faces.size());
+    czm_face::FaceGeometryView view = file.getFaceView();
+    for (const void *array : {static_cast<const void *>(view.x), static_cast<const void *>(view.y),
+                              static_cast<const void *>(view.z), static_cast<const void *>(view.offsets)})
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(array) % czm_face::kBinaryAlignment, 0u);
+    std::vector<double> areas(view.numFaces);
+    czm_face::computeFaceAreas(view, areas.data());
+    EXPECT_EQ(areas, faces.calculateAreas());
+    EXPECT_NEAR(file.getFace(1).calculateArea(), 1.0, 1e-12);
+
+    czm_face::CzmFaceSet loaded;
+    ASSERT_TRUE(czm_face::readFaceSet(facePath, loaded));
+    EXPECT_EQ(loaded.getX(), faces.getX());
+    EXPECT_EQ(loaded.getY(), faces.getY());
+    EXPECT_EQ(loaded.getZ(), faces.getZ());
+    EXPECT_EQ(loaded.getOffsets(), faces.getOffsets());
+
+    // Point clouds keep positions, types and (face id, edge index) pairs
+    std::vector<czm_face::CzmFace> pointFaces = {faces.getFace(0), faces.getFace(1)};
+    auto pointSet = czm_face::generatePointsForFaces(pointFaces, czm_face::PointGenerationMethod::EDGE_AND_INTERIOR, 5);
+    czm_face::CzmPointCloud cloud = czm_face::toPointCloud(pointSet);
+    std::string pointPath = ::testing::TempDir() + "czm_points.bin";
+    ASSERT_TRUE(czm_face::writePointCloud(pointPath, cloud));
+    czm_face::CzmPointCloud loadedCloud;
+    EXPECT_FALSE(czm_face::readPointCloud(facePath, loadedCloud));
+    ASSERT_TRUE(czm_face::readPointCloud(pointPath, loadedCloud));
+    EXPECT_EQ(loadedCloud.getX(), cloud.getX());
+    EXPECT_EQ(loadedCloud.getY(), cloud.getY());
+    EXPECT_EQ(loadedCloud.getZ(), cloud.getZ());
+    EXPECT_EQ(loadedCloud.getTypeBits(), cloud.getTypeBits());
+    EXPECT_EQ(loadedCloud.getFaceIds(), cloud.getFaceIds());
+    EXPECT_EQ(loadedCloud.getEdgeIndices(), cloud.getEdgeIndices());
+
+    // Faces are only read from face set files and within range
+    EXPECT_EQ(file.getFace(file.size()).getNumVertices(), 0);
+    czm_face::BinaryFile pointFile;
+    ASSERT_TRUE(pointFile.open(pointPath));
+    EXPECT_EQ(pointFile.getFaceView().numFaces, 0u);
+    EXPECT_EQ(pointFile.getFace(0).getNumVertices(), 0);
+    pointFile.close();
+    EXPECT_EQ(pointFile.getFace(0).getNumVertices(), 0);
+    EXPECT_EQ(pointFile.size(), 0u);
+    EXPECT_EQ(pointFile.getHeader().version, 0u);
+    EXPECT_EQ(static_cast<std::uint32_t>(pointFile.getContents()), 0u);
+
+    // Truncated and corrupted files are rejected
+    std::ifstream input(facePath, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    std::string brokenPath = ::testing::TempDir() + "czm_broken.bin";
+    std::ofstream(brokenPath, std::ios::binary) << bytes.substr(0, bytes.size() - 64);
+    EXPECT_FALSE(file.open(brokenPath));
+    EXPECT_FALSE(file.isOpen());
+    std::string corrupted = bytes;
+    corrupted[8] = 2; // Version
+    std::ofstream(brokenPath, std::ios::binary | std::ios::trunc) << corrupted;
+    EXPECT_FALSE(czm_face::readFaceSet(brokenPath, loaded));
+    EXPECT_FALSE(file.open(::testing::TempDir() + "czm_missing.bin"));
+
+    std::remove(facePath.c_str());
+    std::remove(pointPath.c_str());
+    std::remove(brokenPath.c_str());
+}
+
+TEST(PointStreamTest, ChunksMatchBulkGeneration)
+{
+    czm_face::SyntheticMeshOptions options;
+    options.kind = czm_face::SyntheticMeshKind::PERTURBED_TRIANGLES;
+    options.numFaces = 57;
+    czm_face::SyntheticMesh mesh(options);
+    std::vector<czm_face::CzmFace> faces = mesh.createFaces();
+    czm_face::CzmFaceSet faceSet;
+    mesh.appendTo(faceSet);
+
+    // Chunks hold whole faces where they fit; faces larger than a chunk
+    // (PARAMETRIC_GRID with 12 points per edge gives 78) are split
+    auto check = [](czm_face::PointStream &stream, const czm_face::FacePointSet &expected)
+    {
+        std::size_t next = 0;
+        std::size_t total = stream.forEachChunk(
+            [&](const czm_face::PointChunk &chunk)
+            {
+                EXPECT_LE(chunk.points.size(), stream.getChunkSize());
+                EXPECT_EQ(chunk.firstPoint, next);
+                for (std::size_t i = 0; i < chunk.points.size(); ++i, ++next)
+                {
+                    ASSERT_LT(next, expected.points.size());
+                    EXPECT_EQ(chunk.points[i].getPosition(), expected.points[next].getPosition());
+                    EXPECT_EQ(chunk.points[i].getEdgeIndex(), expected.points[next].getEdgeIndex());
+                    EXPECT_TRUE(next >= expected.offsets[chunk.faceIds[i]] && next < expected.offsets[chunk.faceIds[i] + 1]);
+                    if (!expected.weights.empty())
+                    {
+                        EXPECT_EQ(chunk.weights[i], expected.weights[next]);
+                    }
+                }
+            });
+        EXPECT_EQ(total, expected.points.size());
+    };
+
+    for (std::size_t chunkSize : {1, 50, 1000, 100000})
+    {
+        czm_face::PointStream grid(faces, czm_face::PointGenerationMethod::PARAMETRIC_GRID, 12, chunkSize);
+        grid.setWithWeights(true);
+        check(grid, czm_face::generateWeightedPointsForFaces(faces, czm_face::PointGenerationMethod::PARAMETRIC_GRID, 12));
+
+        // Methods without a reference pattern split faces from generated points
+        czm_face::PointStream mixed(faceSet, czm_face::PointGenerationMethod::EDGE_AND_INTERIOR, 12, chunkSize);
+        check(mixed, czm_face::generatePointsForFaces(faces, czm_face::PointGenerationMethod::EDGE_AND_INTERIOR, 12));
+
+        czm_face::EqualAreaOptions equalArea;
+        equalArea.seed = 3;
+        auto stream = czm_face::PointStream::equalArea(faceSet, 20, equalArea, chunkSize);
+        auto expected = czm_face::generateEqualAreaPointsForFaces(faces, 20, equalArea);
+        check(stream, expected);
+
+        // Exhausted streams stay empty until reset
+        czm_face::PointChunk chunk;
+        EXPECT_FALSE(stream.next(chunk));
+        stream.reset();
+        check(stream, expected);
+    }
+}
+
+TEST(VtkWriterTest, WritesVtuAndLegacyBinary)
+{
+    czm_face::CzmFaceSet faces;
+    ASSERT_TRUE(faces.addFace(kTriangle));
+    ASSERT_TRUE(faces.addFace(kQuad));
+    std::vector<czm_face::CzmFace> faceList = {faces.getFace(0), faces.getFace(1)};
+    auto pointSet = czm_face::generateWeightedPointsForFaces(faceList, czm_face::PointGenerationMethod::GAUSS, 2);
+    czm_face::CzmPointCloud cloud = czm_face::toPointCloud(pointSet);
+
+    auto readFile = [](const std::string &path)
+    {
+        std::ifstream input(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    };
+
+    // Raw bytes of a named appended VTU array, after its UInt64 byte count
+    auto vtuArray = [](const std::string &file, const std::string &name)
+    {
+        std::size_t tag = file.find("Name=\"" + name + "\"");
+        std::size_t offset = std::stoull(file.substr(file.find("offset=\"", tag) + 8));
+        std::size_t data = file.find('_', file.find("<AppendedData")) + 1 + offset;
+        std::uint64_t size;
+        std::memcpy(&size, file.data() + data, sizeof(size));
+        return file.substr(data + sizeof(size), size);
+    };
+
+    std::string path = ::testing::TempDir() + "czm_faces.vtu";
+    ASSERT_TRUE(czm_face::writeVtkFaces(path, faces));
+    std::string vtu = readFile(path);
+    EXPECT_NE(vtu.find("NumberOfPoints=\"7\" NumberOfCells=\"2\""), std::string::npos);
+    std::string coordinates = vtuArray(vtu, "Points");
+    ASSERT_EQ(coordinates.size(), 7 * 3 * sizeof(double));
+    for (std::size_t k = 0; k < 7; ++k)
+    {
+        double xyz[3];
+        std::memcpy(xyz, coordinates.data() + k * sizeof(xyz), sizeof(xyz));
+        EXPECT_EQ(xyz[0], faces.getX()[k]);
+        EXPECT_EQ(xyz[2], faces.getZ()[k]);
+    }
+    EXPECT_EQ(vtuArray(vtu, "types"), std::string("\x05\x09"));
+    EXPECT_NE(vtu.rfind("</VTKFile>"), std::string::npos);
+
+    path = ::testing::TempDir() + "czm_points.vtu";
+    ASSERT_TRUE(czm_face::writeVtkPoints(path, cloud, pointSet.weights));
+    vtu = readFile(path);
+    std::string types = vtuArray(vtu, "point_type");
+    ASSERT_EQ(types.size(), cloud.size());
+    for (std::size_t i = 0; i < cloud.size(); ++i)
+        EXPECT_EQ(types[i] == 1, cloud.getType(i) == czm_face::PointType::EDGE_POINT);
+    std::string weights = vtuArray(vtu, "weight");
+    ASSERT_EQ(weights.size(), cloud.size() * sizeof(double));
+    EXPECT_EQ(std::memcmp(weights.data(), pointSet.weights.data(), weights.size()), 0);
+    EXPECT_EQ(vtuArray(vtu, "face_id").size(), cloud.size() * sizeof(std::uint32_t));
+
+    // Legacy files store big-endian values after each section header
+    auto bigEndianDouble = [](const std::string &file, std::size_t at)
+    {
+        unsigned char bytes[8];
+        for (int k = 0; k < 8; ++k)
+            bytes[k] = static_cast<unsigned char>(file[at + 7 - k]);
+        double value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    };
+
+    path = ::testing::TempDir() + "czm_faces.vtk";
+    ASSERT_TRUE(czm_face::writeVtkFaces(path, faces, czm_face::VtkFormat::LEGACY_BINARY));
+    std::string legacy = readFile(path);
+    ASSERT_EQ(legacy.compare(0, 26, "# vtk DataFile Version 3.0"), 0);
+    std::size_t pointsAt = legacy.find("POINTS 7 double\n");
+    ASSERT_NE(pointsAt, std::string::npos);
+    pointsAt += std::strlen("POINTS 7 double\n");
+    EXPECT_EQ(bigEndianDouble(legacy, pointsAt + 3 * sizeof(double)), faces.getX()[1]);
+    EXPECT_EQ(legacy.compare(pointsAt + 21 * sizeof(double), 14, "\nPOLYGONS 2 9\n"), 0);
+
+    // Each polygon is its vertex count followed by its vertex indices
+    std::size_t polygonsAt = pointsAt + 21 * sizeof(double) + 14;
+    std::vector<std::int32_t> expectedCells;
+    for (std::size_t f = 0; f < faces.size(); ++f)
+    {
+        expectedCells.push_back(static_cast<std::int32_t>(faces.getOffsets()[f + 1] - faces.getOffsets()[f]));
+        for (std::size_t k = faces.getOffsets()[f]; k < faces.getOffsets()[f + 1]; ++k)
+            expectedCells.push_back(static_cast<std::int32_t>(k));
+    }
+    ASSERT_EQ(expectedCells.size(), 9u);
+    for (std::size_t i = 0; i < expectedCells.size(); ++i)
+    {
+        std::uint32_t value = 0;
+        for (int k = 0; k < 4; ++k)
+            value = (value << 8) | static_cast<unsigned char>(legacy[polygonsAt + 4 * i + k]);
+        EXPECT_EQ(static_cast<std::int32_t>(value), expectedCells[i]) << i;
+    }
+    EXPECT_NE(legacy.find("CELL_DATA 2\nSCALARS face_id int 1\n"), std::string::npos);
+
+    path = ::testing::TempDir() + "czm_points.vtk";
+    ASSERT_TRUE(czm_face::writeVtkPoints(path, cloud, {}, czm_face::VtkFormat::LEGACY_BINARY));
+    legacy = readFile(path);
+    std::string header = "VERTICES " + std::to_string(cloud.size()) + " " + std::to_string(2 * cloud.size()) + "\n";
+    EXPECT_NE(legacy.find(header), std::string::npos);
+    EXPECT_NE(legacy.find("POINT_DATA " + std::to_string(cloud.size()) + "\n"), std::string::npos);
+    EXPECT_NE(legacy.find("SCALARS edge_index char 1"), std::string::npos);
+    EXPECT_EQ(legacy.find("SCALARS weight"), std::string::npos);
+
+    for (const char *name : {"czm_faces.vtu", "czm_points.vtu", "czm_faces.vtk", "czm_points.vtk"})
+        std::remove((::testing::TempDir() + name).c_str());
+}
+
+TEST(CzmFaceTest, ParametricGridOnTiltedFaces)
+{
+    // Quad in the vertical x=z plane, given out of order
+    std::vector<Vec3D> tiltedQuad = {
+        Vec3D(0, 0, 0),
+        Vec3D(2, 1, 2),
+        Vec3D(2, 0, 2),
+        Vec3D(0, 1, 0)};
+
+    const int n = 5;
+    for (const auto &vertices : {kTriangle, tiltedQuad})
+    {
+        czm_face::CzmFace face;
+        ASSERT_TRUE(face.createFace(vertices));
+
+        auto points = face.generatePointGrid(n, czm_face::PointGenerationMethod::PARAMETRIC_GRID);
+        std::size_t expected = (face.getNumVertices() == 4) ? n * n : n * (n + 1) / 2;
+        ASSERT_EQ(points.size(), expected);
+        EXPECT_EQ(face.countPoints(n, czm_face::PointGenerationMethod::PARAMETRIC_GRID), expected);
+
+        std::vector<int> edgeCounts(face.getNumEdges(), 0);
+        for (const auto &point : points)
+        {
+            // Every point lies in the face plane
+            Vec3D offset = point.getPosition() - face.getVertex(0);
+            EXPECT_NEAR(offset.dot(face.getNormal()), 0.0, 1e-12);
+
+            if (point.getType() == czm_face::PointType::EDGE_POINT)
+            {
+                // Edge points lie on their edge
+                ASSERT_GE(point.getEdgeIndex(), 0);
+                czm_face::Edge edge = face.getEdge(point.getEdgeIndex());
+                double distance = (point.getPosition() - edge.getStart()).length() +
+                                  (point.getPosition() - edge.getEnd()).length();
+                EXPECT_NEAR(distance, edge.length(), 1e-12);
+                ++edgeCounts[point.getEdgeIndex()];
+            }
+            else
+            {
+                EXPECT_EQ(point.getEdgeIndex(), -1);
+            }
+        }
+
+        // Each edge owns its start vertex and n - 2 interior edge points
+        for (int count : edgeCounts)
+        {
+            EXPECT_EQ(count, n - 1);
+        }
+    }
+
+    // Vertical quad is ordered cyclically, so it has full area
+    czm_face::CzmFace quad;
+    ASSERT_TRUE(quad.createFace(tiltedQuad));
+    EXPECT_NEAR(quad.calculateArea(), std::sqrt(8.0), 1e-12);
+}
+
+// Rule tables are evaluated at compile time
+static_assert(czm_face::getQuadratureRule1D(czm_face::QuadratureFamily::GAUSS, 2).numPoints == 2, "");
+static_assert(czm_face::getReferenceQuadrature(czm_face::ReferenceShape::QUAD, czm_face::QuadratureFamily::LOBATTO, 3)->numPoints == 9, "");
+
+TEST(QuadratureTest, RulesMatchKnownNodes)
+{
+    auto gauss = czm_face::getQuadratureRule1D(czm_face::QuadratureFamily::GAUSS, 2);
+    EXPECT_NEAR(gauss.nodes[0], 0.5 - 0.5 / std::sqrt(3.0), 1e-15);
+    EXPECT_NEAR(gauss.weights[0], 0.5, 1e-15);
+
+    auto lobatto = czm_face::getQuadratureRule1D(czm_face::QuadratureFamily::LOBATTO, 4);
+    EXPECT_EQ(lobatto.nodes[0], 0.0);
+    EXPECT_NEAR(lobatto.nodes[1], 0.5 - 0.5 / std::sqrt(5.0), 1e-15);
+    EXPECT_NEAR(lobatto.weights[0], 1.0 / 12.0, 1e-15);
+    EXPECT_EQ(lobatto.nodes[3], 1.0);
+
+    EXPECT_EQ(czm_face::getQuadratureRule1D(czm_face::QuadratureFamily::GAUSS, 11).numPoints, 0);
+}
+
+TEST(CzmFaceTest, QuadraturePointsIntegrateExactly)
+{
+    std::vector<Vec3D> unitTriangle = {Vec3D(0, 0, 0), Vec3D(1, 0, 0), Vec3D(0, 1, 0)};
+    std::vector<Vec3D> unitSquare = {Vec3D(0, 0, 0), Vec3D(1, 0, 0), Vec3D(1, 1, 0), Vec3D(0, 1, 0)};
+
+    for (auto method : {czm_face::PointGenerationMethod::GAUSS, czm_face::PointGenerationMethod::LOBATTO})
+    {
+        for (const auto &vertices : {kTriangle, kQuad})
+        {
+            czm_face::CzmFace face;
+            ASSERT_TRUE(face.createFace(vertices));
+            for (int order = czm_face::kMinQuadratureOrder; order <= czm_face::kMaxQuadratureOrder; ++order)
+            {
+                std::vector<double> weights;
+                auto points = face.generatePointGrid(order, method, weights);
+                ASSERT_EQ(points.size(), face.countPoints(order, method));
+                ASSERT_EQ(weights.size(), points.size());
+
+                double sum = 0.0;
+                for (double weight : weights)
+                    sum += weight;
+                EXPECT_NEAR(sum, face.calculateArea(), 1e-12);
+            }
+        }
+
+        // Order 3 Gauss and order 4 Lobatto (both exact to degree 5) integrate x^2 y exactly
+        int order = (method == czm_face::PointGenerationMethod::GAUSS) ? 3 : 4;
+        czm_face::CzmFace triangle, square;
+        ASSERT_TRUE(triangle.createFace(unitTriangle));
+        ASSERT_TRUE(square.createFace(unitSquare));
+
+        auto integrate = [&](const czm_face::CzmFace &face)
+        {
+            std::vector<double> weights;
+            auto points = face.generatePointGrid(order, method, weights);
+            double integral = 0.0;
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                const Vec3D &p = points[i].getPosition();
+                integral += weights[i] * p.comp[0] * p.comp[0] * p.comp[1];
+            }
+            return integral;
+        };
+        EXPECT_NEAR(integrate(square), 1.0 / 6.0, 1e-14);
+        EXPECT_NEAR(integrate(triangle), 1.0 / 60.0, 1e-14);
+    }
+
+    // Lobatto points include the vertices as edge points
+    czm_face::CzmFace square;
+    ASSERT_TRUE(square.createFace(unitSquare));
+    auto points = square.generatePointGrid(3, czm_face::PointGenerationMethod::LOBATTO);
+    ASSERT_EQ(points.size(), 9u);
+    int edgePoints = 0;
+    for (const auto &point : points)
+        edgePoints += (point.getType() == czm_face::PointType::EDGE_POINT) ? 1 : 0;
+    EXPECT_EQ(edgePoints, 8);
+}
+
+TEST(FaceInsideTesterTest, ClassifiesAtEverySimdLevel)
+{
+    // Vertical triangle (x=0 plane) and a non-convex quad (reflex vertex at
+    // the origin) in the z=0 plane; vertex order is kept by createFace
+    std::vector<Vec3D> verticalTriangle = {Vec3D(0, 0, 0), Vec3D(0, 2, 0), Vec3D(0, 0, 2)};
+    std::vector<Vec3D> dart = {Vec3D(-1, -1, 0), Vec3D(0, 0, 0), Vec3D(1, -1, 0), Vec3D(0, 2, 0)};
+
+    // Ray cast reference in the plane of the face
+    auto reference = [](const std::vector<Vec3D> &polygon, double u, double v, int iu, int iv)
+    {
+        bool inside = false;
+        for (std::size_t k = 0, j = polygon.size() - 1; k < polygon.size(); j = k++)
+        {
+            double ku = polygon[k].comp[iu], kv = polygon[k].comp[iv];
+            double ju = polygon[j].comp[iu], jv = polygon[j].comp[iv];
+            if ((kv > v) != (jv > v) && u < (ju - ku) * (v - kv) / (jv - kv) + ku)
+                inside = !inside;
+        }
+        return inside;
+    };
+
+    czm_face::SimdLevel original = czm_face::getSimdLevel();
+    for (const auto &polygon : {verticalTriangle, dart})
+    {
+        czm_face::CzmFace face;
+        ASSERT_TRUE(face.createFace(polygon.data(), polygon.size()));
+        std::vector<Vec3D> vertices(face.getVertices().begin(), face.getVertices().end());
+        czm_face::FaceInsideTester tester(face);
+        int iu = (tester.getAxis() + 1) % 3, iv = (tester.getAxis() + 2) % 3;
+
+        // Off-lattice sample points so none lies on an edge
+        std::vector<Vec3D> points;
+        for (int i = 0; i < 37; ++i)
+        {
+            for (int j = 0; j < 41; ++j)
+            {
+                Vec3D point(0.5, 0.5, 0.5);
+                point.comp[iu] = -1.5 + 3.7 * (i + 0.31) / 37;
+                point.comp[iv] = -1.5 + 3.9 * (j + 0.17) / 41;
+                points.push_back(point);
+            }
+        }
+
+        std::size_t expectedInside = 0;
+        for (const auto &point : points)
+        {
+            bool expected = reference(vertices, point.comp[iu], point.comp[iv], iu, iv);
+            EXPECT_EQ(tester.contains(point), expected);
+            expectedInside += expected ? 1 : 0;
+        }
+        EXPECT_GT(expectedInside, 0u);
+
+        for (auto level : {czm_face::SimdLevel::SCALAR, czm_face::SimdLevel::AVX2, czm_face::SimdLevel::AVX512})
+        {
+            czm_face::setSimdLevel(level);
+            std::vector<std::uint64_t> mask((points.size() + 63) / 64, ~std::uint64_t(0));
+            EXPECT_EQ(tester.classify(points, mask), expectedInside);
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                EXPECT_EQ(((mask[i / 64] >> (i % 64)) & 1u) != 0, tester.contains(points[i])) << i;
+            }
+        }
+    }
+    czm_face::setSimdLevel(original);
+}
+
+TEST(FaceInsideTesterTest, FloatClassifyMatchesDouble)
+{
+    // Faces away from the origin, one of them too small for float, with
+    // points on, next to and away from their edges
+    std::vector<std::vector<Vec3D>> polygons = {
+        {Vec3D(1000, 500, 3), Vec3D(1002, 500, 3), Vec3D(1000, 501, 4)},
+        {Vec3D(-1, -1, 0), Vec3D(0, 0, 0), Vec3D(1, -1, 0), Vec3D(0, 2, 0)},
+        {Vec3D(4096, 0, 0), Vec3D(4096.0001, 0, 0), Vec3D(4096.0001, 0.0001, 0), Vec3D(4096, 0.0001, 0)}};
+
+    czm_face::SimdLevel original = czm_face::getSimdLevel();
+    for (const auto &polygon : polygons)
+    {
+        czm_face::CzmFace face;
+        ASSERT_TRUE(face.createFace(polygon.data(), polygon.size()));
+        czm_face::FaceInsideTester tester(face);
+
+        std::vector<Vec3f> points;
+        for (int i = 0; i <= 40; ++i)
+        {
+            for (int j = 0; j <= 40; ++j)
+            {
+                double s = -0.25 + 1.5 * i / 40, t = -0.25 + 1.5 * j / 40;
+                Vec3D point = polygon[0] + s * (polygon[1] - polygon[0]) + t * (polygon.back() - polygon[0]);
+                Vec3f single(static_cast<float>(point.comp[0]), static_cast<float>(point.comp[1]),
+                             static_cast<float>(point.comp[2]));
+                points.push_back(single);
+                single.comp[0] = std::nextafter(single.comp[0], 1e9f);
+                points.push_back(single);
+            }
+        }
+        std::vector<Vec3D> converted;
+        for (const auto &point : points)
+            converted.emplace_back(point.comp[0], point.comp[1], point.comp[2]);
+
+        std::vector<std::uint64_t> expected((points.size() + 63) / 64);
+        std::size_t expectedInside = tester.classify(converted, expected);
+        EXPECT_GT(expectedInside, 0u);
+        for (auto level : {czm_face::SimdLevel::SCALAR, czm_face::SimdLevel::AVX2, czm_face::SimdLevel::AVX512})
+        {
+            czm_face::setSimdLevel(level);
+            std::vector<std::uint64_t> mask(expected.size(), ~std::uint64_t(0));
+            EXPECT_EQ(tester.classify(points, mask), expectedInside);
+            EXPECT_EQ(mask, expected);
+        }
+    }
+    czm_face::setSimdLevel(original);
+}
+
+TEST(SyntheticMeshTest, StreamsReproducibleConformingMeshes)
+{
+    // Full 32 x 32 lattices, so conforming faces share (32 + 1)^2 vertices
+    for (auto kind : {czm_face::SyntheticMeshKind::STRUCTURED_QUADS, czm_face::SyntheticMeshKind::PERTURBED_TRIANGLES,
+                      czm_face::SyntheticMeshKind::SKEWED_QUADS, czm_face::SyntheticMeshKind::SLIVER_TRIANGLES})
+    {
+        czm_face::SyntheticMeshOptions options;
+        options.kind = kind;
+        options.seed = 7;
+        options.spacing = 0.5;
+        options.origin = Vec3D(10, -3, 2);
+        options.normal = Vec3D(1, 2, 2);
+        czm_face::SyntheticMesh probe(options);
+        options.numFaces = (probe.getVerticesPerFace() == 3) ? 2 * 32 * 32 : 32 * 32;
+        czm_face::SyntheticMesh mesh(options);
+        ASSERT_EQ(mesh.size(), options.numFaces);
+        EXPECT_NEAR(mesh.getNormal().comp[0], 1.0 / 3.0, 1e-12);
+
+        czm_face::CzmFaceSet faceSet;
+        mesh.appendTo(faceSet);
+        std::vector<czm_face::CzmFace> faces = mesh.createFaces();
+        ASSERT_EQ(faceSet.size(), options.numFaces);
+        ASSERT_EQ(faces.size(), options.numFaces);
+
+        // Faces lie in the plane and tile the lattice; createFace re-sorts
+        // quad vertices, which may flip quad normals
+        double area = 0.0;
+        std::set<std::tuple<double, double, double>> nodes;
+        for (std::size_t f = 0; f < faces.size(); ++f)
+        {
+            EXPECT_NEAR(std::fabs(faces[f].getNormal().dot(mesh.getNormal())), 1.0, 1e-9) << f;
+            EXPECT_NEAR(faces[f].calculateArea(), faceSet.getFace(f).calculateArea(), 1e-12);
+            area += faces[f].calculateArea();
+            for (const Vec3D &vertex : faces[f].getVertices())
+            {
+                EXPECT_NEAR((vertex - options.origin).dot(mesh.getNormal()), 0.0, 1e-9);
+                nodes.emplace(vertex.comp[0], vertex.comp[1], vertex.comp[2]);
+            }
+        }
+        EXPECT_EQ(nodes.size(), 33u * 33u);
+        if (kind == czm_face::SyntheticMeshKind::STRUCTURED_QUADS || kind == czm_face::SyntheticMeshKind::SKEWED_QUADS)
+        {
+            EXPECT_NEAR(area, 32 * 32 * 0.25, 1e-9);
+        }
+        if (kind == czm_face::SyntheticMeshKind::SLIVER_TRIANGLES)
+        {
+            EXPECT_NEAR(area, 32 * 32 * 0.25 / options.aspectRatio, 1e-9);
+        }
+
+        // Any face range is reproducible on its own
+        Vec3D vertices[4];
+        int count = mesh.getFace(777, vertices);
+        czm_face::SyntheticMesh again(options);
+        again.visitFaces(777, 778, [&](const Vec3D *face, int faceCount)
+                         {
+                             ASSERT_EQ(faceCount, count);
+                             for (int k = 0; k < count; ++k)
+                                 EXPECT_EQ(face[k], vertices[k]);
+                         });
+    }
+
+    // Other seeds move the perturbed nodes; random orientations are unit normals
+    czm_face::SyntheticMeshOptions options;
+    options.kind = czm_face::SyntheticMeshKind::PERTURBED_TRIANGLES;
+    options.randomOrientation = true;
+    Vec3D a[3], b[3];
+    czm_face::SyntheticMesh(options).getFace(5, a);
+    options.seed = 1;
+    czm_face::SyntheticMesh other(options);
+    other.getFace(5, b);
+    EXPECT_FALSE(a[0] == b[0]);
+    EXPECT_NEAR(other.getNormal().length(), 1.0, 1e-12);
+}
+
+TEST(SyntheticMeshTest, PerturbedTrianglesKeepPositiveArea)
+{
+    // Perturbations beyond the limit are clamped
+    czm_face::SyntheticMeshOptions options;
+    options.kind = czm_face::SyntheticMeshKind::PERTURBED_TRIANGLES;
+    options.perturbation = 0.4;
+    EXPECT_EQ(czm_face::SyntheticMesh(options).getOptions().perturbation, czm_face::SyntheticMesh::kMaxPerturbation);
+
+    // Every face is counter-clockwise about the mesh normal with positive area
+    options.numFaces = 20000;
+    options.normal = Vec3D(-1, 2, 0.5);
+    for (double perturbation : {0.0, czm_face::SyntheticMeshOptions().perturbation,
+                                czm_face::SyntheticMesh::kMaxPerturbation, 1.0})
+    {
+        for (std::uint64_t seed : {0u, 3u})
+        {
+            options.perturbation = perturbation;
+            options.seed = seed;
+            czm_face::SyntheticMesh mesh(options);
+            double minArea = std::numeric_limits<double>::max();
+            mesh.visitFaces(0, mesh.size(), [&](const Vec3D *vertices, int count)
+                            {
+                                ASSERT_EQ(count, 3);
+                                double area = 0.5 * (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]).dot(mesh.getNormal());
+                                minArea = std::min(minArea, area); });
+            EXPECT_GT(minArea, 0.0) << perturbation << " " << seed;
+        }
+    }
+}
+
+TEST(FaceBvhTest, QueriesMatchBruteForce)
+{
+    // Wavy sheet of quads and triangles with some faces tilted out of plane
+    czm_face::CzmFaceSet faces;
+    const int n = 24;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            double z0 = 0.1 * std::sin(0.5 * i), z1 = 0.1 * std::sin(0.5 * (i + 1));
+            Vec3D a(i, j, z0), b(i + 1, j, z1), c(i + 1, j + 1, z1), d(i, j + 1, z0);
+            if ((i + j) % 3 == 0)
+            {
+                ASSERT_TRUE(faces.addFace({a, b, c}));
+                ASSERT_TRUE(faces.addFace({a, c, d}));
+            }
+            else
+            {
+                ASSERT_TRUE(faces.addFace({a, b, c, d}));
+            }
+        }
+    }
+
+    czm_face::FaceBvh bvh;
+    bvh.build(faces);
+    ASSERT_EQ(bvh.size(), faces.size());
+    ASSERT_FALSE(bvh.getNodes().empty());
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(-2.0, n + 2.0);
+    std::uniform_real_distribution<double> height(-0.5, 0.5);
+    std::vector<Vec3D> points;
+    for (int k = 0; k < 150; ++k)
+        points.emplace_back(coord(gen), coord(gen), height(gen));
+
+    std::vector<int> nearest = bvh.findNearestFaces(points);
+    for (std::size_t k = 0; k < points.size(); ++k)
+    {
+        // Brute force distance to every face through the point grid of the face
+        double bvhDistance = 0.0;
+        ASSERT_EQ(bvh.findNearestFace(points[k], &bvhDistance), nearest[k]);
+        ASSERT_GE(nearest[k], 0);
+
+        double best = std::numeric_limits<double>::max();
+        for (std::size_t f = 0; f < faces.size(); ++f)
+        {
+            czm_face::CzmFace face = faces.getFace(f);
+            for (const auto &point : face.generatePointGrid(9, czm_face::PointGenerationMethod::PARAMETRIC_GRID))
+                best = std::min(best, (point.getPosition() - points[k]).length());
+        }
+        // The lattice only samples the faces, so it can only be farther away
+        EXPECT_LE(bvhDistance, best + 1e-12);
+        EXPECT_GE(bvhDistance, best - 0.1);
+    }
+
+    // Points on the sheet map back to the face they were generated on
+    std::vector<Vec3D> centers = faces.calculateCenters();
+    std::vector<int> containing = bvh.findContainingFaces(centers, 1e-9);
+    for (std::size_t f = 0; f < faces.size(); ++f)
+    {
+        EXPECT_EQ(containing[f], static_cast<int>(f));
+    }
+    EXPECT_EQ(bvh.findContainingFace(Vec3D(-1, -1, 0), 1e-9), -1);
+
+    // Box overlap agrees with a linear scan
+    czm_face::BoundingBox box;
+    box.expand(Vec3D(3.5, 4.5, -1));
+    box.expand(Vec3D(7.2, 6.1, 1));
+    std::vector<std::uint32_t> overlapping;
+    bvh.findOverlappingFaces(box, overlapping);
+    std::sort(overlapping.begin(), overlapping.end());
+
+    std::vector<std::uint32_t> expected;
+    for (std::size_t f = 0; f < faces.size(); ++f)
+    {
+        if (faces.getFace(f).calculateBoundingBox().overlaps(box))
+            expected.push_back(static_cast<std::uint32_t>(f));
+    }
+    EXPECT_EQ(overlapping, expected);
+}
+
+TEST(CzmFacePairerTest, FindsCoincidentFacesWithinTolerance)
+{
+    // Grid of triangles; every third one gets a reversed, slightly perturbed
+    // twin appended at the end, and every fifth quad gets an exact twin
+    czm_face::CzmFaceSet faces;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> expected;
+    std::vector<std::vector<Vec3D>> twins;
+    std::vector<std::uint32_t> twinOf;
+    for (int i = 0; i < 40; ++i)
+    {
+        for (int j = 0; j < 40; ++j)
+        {
+            Vec3D a(i, j, 0), b(i + 1, j, 0), c(i + 1, j + 1, 0.5), d(i, j + 1, 0.5);
+            std::uint32_t index = static_cast<std::uint32_t>(faces.size());
+            if ((i + j) % 2 == 0)
+            {
+                ASSERT_TRUE(faces.addFace({a, b, c}));
+                if (index % 3 == 0)
+                {
+                    twins.push_back({c + 1e-10, b - 1e-10, a});
+                    twinOf.push_back(index);
+                }
+            }
+            else
+            {
+                ASSERT_TRUE(faces.addFace({a, b, c, d}));
+                if (index % 5 == 0)
+                {
+                    twins.push_back({d, c, b, a});
+                    twinOf.push_back(index);
+                }
+            }
+        }
+    }
+    for (std::size_t k = 0; k < twins.size(); ++k)
+    {
+        expected.emplace_back(twinOf[k], static_cast<std::uint32_t>(faces.size()));
+        ASSERT_TRUE(faces.addFace(twins[k]));
+    }
+
+    // A face shifted by more than the tolerance is not paired
+    ASSERT_TRUE(faces.addFace({Vec3D(0, 0, 1e-6), Vec3D(1, 0, 1e-6), Vec3D(1, 1, 0.5)}));
+
+    czm_face::FacePairingOptions options;
+    options.tolerance = 1e-9;
+    czm_face::CzmFacePairer pairer(options);
+    std::vector<czm_face::FacePair> pairs = pairer.findPairs(faces);
+    ASSERT_EQ(pairs.size(), expected.size());
+    for (std::size_t k = 0; k < pairs.size(); ++k)
+    {
+        EXPECT_EQ(pairs[k].first, expected[k].first);
+        EXPECT_EQ(pairs[k].second, expected[k].second);
+
+        // Reversed triangles have opposite normals; quads use a canonical winding
+        bool triangle = faces.getNumVertices(pairs[k].first) == 3;
+        EXPECT_EQ(pairs[k].oppositeNormals, triangle);
+    }
+
+    options.requireOppositeNormals = true;
+    std::size_t triangles = 0;
+    for (const auto &pair : pairs)
+        triangles += (faces.getNumVertices(pair.first) == 3) ? 1 : 0;
+    EXPECT_EQ(czm_face::CzmFacePairer(options).findPairs(faces).size(), triangles);
+}
+
+TEST(FaceTopologyTest, DeduplicatesSharedVerticesAndEdges)
+{
+    // 3x3 grid of quads; vertices of odd faces carry a tiny perturbation
+    czm_face::CzmFaceSet faces;
+    const int n = 3;
+    for (int i = 0; i < n; ++i)
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            double noise = ((i + j) % 2) ? 1e-12 : 0.0;
+            ASSERT_TRUE(faces.addFace({Vec3D(i, j, 0) + noise, Vec3D(i + 1, j, 0) + noise,
+                                       Vec3D(i + 1, j + 1, 0) + noise, Vec3D(i, j + 1, 0) + noise}));
+        }
+    }
+
+    czm_face::FaceTopology topology;
+    topology.build(faces, 1e-9);
+    EXPECT_EQ(topology.getNumFaces(), 9u);
+    EXPECT_EQ(topology.getNumVertices(), 16u);
+    EXPECT_EQ(topology.getNumEdges(), 24u);
+
+    std::size_t boundary = 0;
+    for (std::size_t e = 0; e < topology.getNumEdges(); ++e)
+    {
+        std::size_t count = topology.getNumEdgeFaces(e);
+        EXPECT_TRUE(count == 1 || count == 2);
+        boundary += (count == 1) ? 1 : 0;
+
+        // Every adjacent face lists the edge
+        for (std::size_t k = topology.getEdgeFaceOffsets()[e]; k < topology.getEdgeFaceOffsets()[e + 1]; ++k)
+        {
+            std::uint32_t face = topology.getEdgeFaces()[k];
+            auto first = topology.getFaceEdges().begin() + topology.getFaceOffsets()[face];
+            auto last = topology.getFaceEdges().begin() + topology.getFaceOffsets()[face + 1];
+            EXPECT_NE(std::find(first, last, e), last);
+        }
+    }
+    EXPECT_EQ(boundary, 12u);
+
+    // Shared edge points are emitted once and lie on their attributed edge
+    const int pointsPerEdge = 5;
+    czm_face::CzmPointCloud cloud = topology.generateEdgePoints(pointsPerEdge);
+    ASSERT_EQ(cloud.size(), topology.countEdgePoints(pointsPerEdge));
+    EXPECT_EQ(cloud.size(), 16u + 24u * 3u);
+    for (std::size_t i = 0; i < cloud.size(); ++i)
+    {
+        czm_face::Edge edge = faces.getFace(cloud.getFaceId(i)).getEdge(cloud.getEdgeIndex(i));
+        double distance = (cloud.getPosition(i) - edge.getStart()).length() +
+                          (cloud.getPosition(i) - edge.getEnd()).length();
+        EXPECT_NEAR(distance, edge.length(), 1e-9);
+    }
+
+    // Without a tolerance the perturbed vertices stay separate
+    topology.build(faces);
+    EXPECT_GT(topology.getNumVertices(), 16u);
+}
+
+TEST(PhiloxTest, MatchesKnownAnswers)
+{
+    // Known answer vectors of the Random123 reference implementation
+    using Philox = czm_face::Philox4x32;
+    EXPECT_EQ(Philox::generate({0, 0, 0, 0}, {0, 0}),
+              (Philox::Counter{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+    EXPECT_EQ(Philox::generate({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u}),
+              (Philox::Counter{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+
+    czm_face::PhiloxStream stream(1, 2);
+    for (int i = 0; i < 100; ++i)
+    {
+        double value = stream.nextDouble();
+        EXPECT_GE(value, 0.0);
+        EXPECT_LT(value, 1.0);
+    }
+}
+
+TEST(CzmFaceTest, EqualAreaSamplingIsReproducible)
+{
+    std::vector<czm_face::CzmFace> faces(64);
+    for (std::size_t f = 0; f < faces.size(); ++f)
+    {
+        double s = 1.0 + 0.1 * f;
+        ASSERT_TRUE(faces[f].createFace((f % 2) ? std::vector<Vec3D>{s * kQuad[0], s * kQuad[1], s * kQuad[2], s * kQuad[3]}
+                                                : std::vector<Vec3D>{s * kTriangle[0], s * kTriangle[1], s * kTriangle[2]}));
+    }
+
+    for (auto selection : {czm_face::EqualAreaSelection::RANDOM, czm_face::EqualAreaSelection::STRATIFIED})
+    {
+        czm_face::EqualAreaOptions options;
+        options.seed = 1234;
+        options.selection = selection;
+
+        // Same options give the same points, for any thread count
+        czm_face::ThreadPool single(1), many(4);
+        auto a = czm_face::generateEqualAreaPointsForFaces(faces, 7, options, single);
+        auto b = czm_face::generateEqualAreaPointsForFaces(faces, 7, options, many);
+        ASSERT_EQ(a.offsets, b.offsets);
+        for (std::size_t i = 0; i < a.points.size(); ++i)
+            EXPECT_EQ(a.points[i].getPosition(), b.points[i].getPosition());
+
+        // Face i uses stream faceId + i, like a direct call
+        czm_face::EqualAreaOptions faceOptions = options;
+        faceOptions.faceId = 5;
+        auto direct = faces[5].generateEqualAreaPoints(7, faceOptions);
+        ASSERT_EQ(direct.size(), a.getFacePoints(5).size());
+        for (std::size_t i = 0; i < direct.size(); ++i)
+            EXPECT_EQ(direct[i].getPosition(), a.getFacePoints(5)[i].getPosition());
+    }
+
+    // Stratified selection hits the exact count with area-uniform points on
+    // a tilted quad: half of the points fall in each half of the face
+    std::vector<Vec3D> tiltedQuad = {Vec3D(0, 0, 0), Vec3D(2, 0, 2), Vec3D(2, 1, 2), Vec3D(0, 1, 0)};
+    czm_face::CzmFace quad;
+    ASSERT_TRUE(quad.createFace(tiltedQuad));
+    czm_face::EqualAreaOptions options;
+    options.selection = czm_face::EqualAreaSelection::STRATIFIED;
+    auto points = quad.generateEqualAreaPoints(400, options);
+    ASSERT_EQ(points.size(), 400u);
+
+    czm_face::FaceInsideTester tester(quad);
+    int lowerHalf = 0;
+    for (const auto &point : points)
+    {
+        Vec3D offset = point.getPosition() - quad.getVertex(0);
+        EXPECT_NEAR(offset.dot(quad.getNormal()), 0.0, 1e-12);
+        EXPECT_TRUE(tester.contains(point.getPosition()));
+        lowerHalf += (point.getPosition().comp[0] < 1.0) ? 1 : 0;
+    }
+    EXPECT_NEAR(lowerHalf, 200, 10);
+}
+
+TEST(CzmFaceTest, CentroidalPointsHaveTributaryAreas)
+{
+    czm_face::EqualAreaOptions options;
+    options.selection = czm_face::EqualAreaSelection::CENTROIDAL;
+
+    // A planar trapezoid has a non-constant bilinear Jacobian
+    std::vector<Vec3D> trapezoid = {Vec3D(0, 0, 0), Vec3D(3, 0, 0), Vec3D(2, 1, 1), Vec3D(1, 1, 1)};
+    czm_face::CzmFace triangle, quad;
+    ASSERT_TRUE(triangle.createFace(kTriangle));
+    ASSERT_TRUE(quad.createFace(trapezoid));
+
+    for (const czm_face::CzmFace *face : {&triangle, &quad})
+    {
+        std::vector<double> areas;
+        auto points = face->generateEqualAreaPoints(37, options, areas);
+        ASSERT_EQ(points.size(), 37u);
+        ASSERT_EQ(face->countEqualAreaPoints(37, options), 37u);
+
+        // Cells tile the face, and the converged layout keeps them close to equal
+        double total = 0.0, smallest = areas[0], largest = areas[0];
+        czm_face::FaceInsideTester tester(*face);
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            EXPECT_TRUE(tester.contains(points[i].getPosition()));
+            total += areas[i];
+            smallest = std::min(smallest, areas[i]);
+            largest = std::max(largest, areas[i]);
+        }
+        EXPECT_NEAR(total, face->calculateArea(), 1e-12 * face->calculateArea());
+        EXPECT_LT(largest / smallest, 2.0);
+    }
+
+    // Converged layouts are computed once per shape and count
+    const auto &layout = czm_face::getCentroidalLayout(czm_face::ReferenceShape::QUAD, 37);
+    EXPECT_EQ(&layout, &czm_face::getCentroidalLayout(czm_face::ReferenceShape::QUAD, 37));
+    ASSERT_EQ(layout.size(), 37u);
+    EXPECT_LT(layout.iterations, 1000);
+
+    // Small and large counts converge on both shapes, including the two point
+    // triangle whose plain Lloyd iteration only converges sublinearly
+    for (auto shape : {czm_face::ReferenceShape::TRIANGLE, czm_face::ReferenceShape::QUAD})
+    {
+        for (int count : {2, 3, 500})
+        {
+            auto converged = czm_face::computeCentroidalLayout(shape, count);
+            EXPECT_LT(converged.iterations, 1000) << count;
+        }
+    }
+}
+
+TEST(CzmFaceTest, PointWeightsAreTributaryMeasures)
+{
+    std::vector<Vec3D> trapezoid = {Vec3D(0, 0, 0), Vec3D(3, 0, 0), Vec3D(2, 1, 1), Vec3D(1, 1, 1)};
+    for (const auto &vertices : {kTriangle, kQuad, trapezoid})
+    {
+        czm_face::CzmFace face;
+        ASSERT_TRUE(face.createFace(vertices));
+        auto sum = [](const std::vector<double> &weights)
+        {
+            double total = 0.0;
+            for (double weight : weights)
+                total += weight;
+            return total;
+        };
+
+        // Edge points split each edge into halves of adjacent segments
+        std::vector<double> weights;
+        auto points = face.generatePointGrid(5, czm_face::PointGenerationMethod::EDGE_ONLY, weights);
+        ASSERT_EQ(weights.size(), points.size());
+        EXPECT_NEAR(sum(weights), face.calculatePerimeter(), 1e-12);
+
+        // Parametric lattice dual cells tile the (planar) face
+        points = face.generatePointGrid(6, czm_face::PointGenerationMethod::PARAMETRIC_GRID, weights);
+        ASSERT_EQ(weights.size(), points.size());
+        EXPECT_NEAR(sum(weights), face.calculateArea(), 1e-12);
+    }
+
+    // Grid cells are clipped to the face: full cells inside, partial ones at the boundary
+    std::vector<Vec3D> square = {2.0 * kQuad[0], 2.0 * kQuad[1], 2.0 * kQuad[2], 2.0 * kQuad[3]};
+    czm_face::CzmFace face;
+    ASSERT_TRUE(face.createFace(square));
+    std::vector<double> weights;
+    auto points = face.generatePointGrid(5, czm_face::PointGenerationMethod::UNIFORM_GRID, weights);
+    ASSERT_FALSE(points.empty());
+    double cell = 0.5 * 0.5;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const Vec3D &p = points[i].getPosition();
+        bool boundary = p.comp[0] < 0.25 || p.comp[0] > 1.75 || p.comp[1] < 0.25 || p.comp[1] > 1.75;
+        EXPECT_GT(weights[i], 0.0);
+        if (boundary)
+            EXPECT_LT(weights[i], cell);
+        else
+            EXPECT_NEAR(weights[i], cell, 1e-12);
+    }
+
+    // Random equal area points stand for their clipped cells
+    std::vector<double> areas;
+    points = face.generateEqualAreaPoints(9, czm_face::EqualAreaOptions(), areas);
+    ASSERT_EQ(areas.size(), points.size());
+    for (double area : areas)
+        EXPECT_GT(area, 0.0);
+
+    // The engine stores the same weights alongside the points
+    std::vector<czm_face::CzmFace> faces(3, face);
+    auto result = czm_face::generateWeightedPointsForFaces(faces, czm_face::PointGenerationMethod::UNIFORM_GRID, 5);
+    ASSERT_EQ(result.weights.size(), result.points.size());
+    for (std::size_t f = 0; f < faces.size(); ++f)
+    {
+        ASSERT_EQ(result.getFaceWeights(f).size(), weights.size());
+        for (std::size_t i = 0; i < weights.size(); ++i)
+            EXPECT_EQ(result.getFaceWeights(f)[i], weights[i]);
+    }
+    EXPECT_TRUE(czm_face::generatePointsForFaces(faces, czm_face::PointGenerationMethod::UNIFORM_GRID, 5).weights.empty());
+}
+
+TEST(ReferencePatternCacheTest, SharesLayoutsAcrossFacesAndThreads)
+{
+    auto &cache = czm_face::ReferencePatternCache::getDefault();
+    EXPECT_EQ(cache.getPattern(czm_face::ReferenceShape::QUAD, czm_face::PointGenerationMethod::UNIFORM_GRID, 5), nullptr);
+
+    // Concurrent lookups of one key all get the same pattern
+    czm_face::ThreadPool pool(4);
+    std::vector<const czm_face::ReferencePattern *> found(64);
+    pool.parallelFor(found.size(), 1, [&](std::size_t begin, std::size_t end)
+                     {
+                         for (std::size_t i = begin; i < end; ++i)
+                             found[i] = cache.getPattern(czm_face::ReferenceShape::TRIANGLE,
+                                                         czm_face::PointGenerationMethod::PARAMETRIC_GRID, 7); });
+    ASSERT_NE(found[0], nullptr);
+    for (const auto *pattern : found)
+        EXPECT_EQ(pattern, found[0]);
+    EXPECT_EQ(found[0]->size(), 28u);
+
+    // Mapping the cached patterns gives exactly the per-face points and weights
+    std::vector<czm_face::CzmFace> faces(2);
+    ASSERT_TRUE(faces[0].createFace(kTriangle));
+    ASSERT_TRUE(faces[1].createFace(kQuad));
+    for (auto method : {czm_face::PointGenerationMethod::EDGE_ONLY, czm_face::PointGenerationMethod::PARAMETRIC_GRID,
+                        czm_face::PointGenerationMethod::GAUSS, czm_face::PointGenerationMethod::LOBATTO})
+    {
+        auto result = czm_face::generateWeightedPointsForFaces(faces, method, 4, pool);
+        for (std::size_t f = 0; f < faces.size(); ++f)
+        {
+            std::vector<double> weights;
+            auto points = faces[f].generatePointGrid(4, method, weights);
+            ASSERT_EQ(result.getFacePoints(f).size(), points.size());
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                EXPECT_EQ(result.getFacePoints(f)[i].getPosition(), points[i].getPosition());
+                EXPECT_EQ(result.getFacePoints(f)[i].getEdgeIndex(), points[i].getEdgeIndex());
+                EXPECT_EQ(result.getFaceWeights(f)[i], weights[i]);
+            }
+        }
+    }
+
+    // A pattern only maps onto faces of its shape
+    const auto *quadPattern = cache.getPattern(czm_face::ReferenceShape::QUAD, czm_face::PointGenerationMethod::GAUSS, 2);
+    std::vector<czm_face::CZM_Point> buffer(quadPattern->size());
+    EXPECT_EQ(faces[0].mapReferencePattern(*quadPattern, buffer), 0u);
+    EXPECT_EQ(faces[1].mapReferencePattern(*quadPattern, buffer), 4u);
+
+    // The per-thread lookup hands out the cached patterns
+    EXPECT_EQ(czm_face::getDefaultReferencePattern(czm_face::ReferenceShape::TRIANGLE,
+                                                   czm_face::PointGenerationMethod::PARAMETRIC_GRID, 7),
+              found[0]);
+    EXPECT_EQ(czm_face::getDefaultReferencePattern(czm_face::ReferenceShape::QUAD,
+                                                   czm_face::PointGenerationMethod::GAUSS, 2),
+              quadPattern);
+
+    // Densities above the limit are not cached but still generate the same
+    // points on single faces (in closed form) and in batches
+    int large = czm_face::ReferencePatternCache::kMaxCachedDensity + 1;
+    std::size_t cached = cache.size();
+    EXPECT_EQ(cache.getPattern(czm_face::ReferenceShape::TRIANGLE, czm_face::PointGenerationMethod::PARAMETRIC_GRID,
+                               large),
+              nullptr);
+    for (auto method : {czm_face::PointGenerationMethod::EDGE_ONLY, czm_face::PointGenerationMethod::PARAMETRIC_GRID})
+    {
+        auto result = czm_face::generateWeightedPointsForFaces(faces, method, large, pool);
+        for (std::size_t f = 0; f < faces.size(); ++f)
+        {
+            std::vector<double> weights;
+            auto points = faces[f].generatePointGrid(large, method, weights);
+            EXPECT_EQ(points.size(), faces[f].countPoints(large, method));
+            ASSERT_EQ(result.getFacePoints(f).size(), points.size());
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                EXPECT_EQ(result.getFacePoints(f)[i].getPosition(), points[i].getPosition());
+                EXPECT_EQ(result.getFaceWeights(f)[i], weights[i]);
+            }
+        }
+    }
+    EXPECT_EQ(cache.size(), cached);
+
+    // Invalid densities are rejected without growing the cache
+    for (int density : {0, -1, -1000})
+        EXPECT_EQ(cache.getPattern(czm_face::ReferenceShape::QUAD, czm_face::PointGenerationMethod::GAUSS, density),
+                  nullptr);
+    EXPECT_EQ(cache.size(), cached);
+}
+
+TEST(CzmFaceTest, UpdateVerticesKeepsTopology)
+{
+    czm_face::CzmFace quad;
+    ASSERT_TRUE(quad.createFace(kQuad));
+    const std::vector<Vec3D> &order = kQuad;
+
+    // Stretch in x and lift in z; vertices keep their places and edges
+    std::vector<Vec3D> moved;
+    for (const auto &v : order)
+        moved.push_back(Vec3D(3.0 * v.comp[0], v.comp[1], 2.0));
+    ASSERT_TRUE(quad.updateVertices(moved));
+
+    czm_face::CzmFace recreated;
+    ASSERT_TRUE(recreated.createFace(moved));
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(quad.getVertex(i), recreated.getVertex(i));
+    EXPECT_DOUBLE_EQ(quad.calculateArea(), 3.0);
+    EXPECT_EQ(quad.calculateArea(), recreated.calculateArea());
+    EXPECT_EQ(quad.calculateCenter(), recreated.calculateCenter());
+    EXPECT_EQ(quad.getNormal(), recreated.getNormal());
+
+    // Copies carry the cached values; a second update invalidates them again
+    czm_face::CzmFace copy = quad;
+    ASSERT_TRUE(quad.updateVertices(order));
+    EXPECT_DOUBLE_EQ(quad.calculateArea(), 1.0);
+    EXPECT_DOUBLE_EQ(copy.calculateArea(), 3.0);
+
+    // Topology is fixed: the vertex count must match
+    EXPECT_FALSE(quad.updateVertices(kTriangle));
+    czm_face::CzmFace empty;
+    EXPECT_FALSE(empty.updateVertices(kTriangle));
+}
+
+TEST(CzmFaceTest, UpdateVerticesFollowsCreateOrder)
+{
+    // Vertices given out of cyclic order are reordered by createFace
+    std::vector<Vec3D> input = {Vec3D(0, 0, 0), Vec3D(2, 1, 0), Vec3D(2, 0, 0), Vec3D(0, 1, 0)};
+    czm_face::CzmFace quad;
+    ASSERT_TRUE(quad.createFace(input));
+    ASSERT_FALSE(std::equal(input.begin(), input.end(), quad.getVertices().begin()));
+
+    // Updates in the input order land where createFace put each vertex
+    std::vector<Vec3D> moved;
+    for (const auto &v : input)
+        moved.push_back(Vec3D(v.comp[0] + 0.5 * v.comp[1], 1.5 * v.comp[1], 0.25 * v.comp[0]));
+    ASSERT_TRUE(quad.updateVertices(moved));
+
+    czm_face::CzmFace recreated;
+    ASSERT_TRUE(recreated.createFace(moved));
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(quad.getVertex(i), recreated.getVertex(i));
+    EXPECT_EQ(quad.calculateArea(), recreated.calculateArea());
+    EXPECT_EQ(quad.getNormal(), recreated.getNormal());
+    // The 2 x 1 rectangle scales by |(1, 0, 0.25) x (0.5, 1.5, 0)|
+    EXPECT_DOUBLE_EQ(quad.calculateArea(), 2.0 * std::sqrt(0.375 * 0.375 + 0.125 * 0.125 + 1.5 * 1.5));
+
+    // Updating twice with the same input keeps the face
+    ASSERT_TRUE(quad.updateVertices(moved));
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(quad.getVertex(i), recreated.getVertex(i));
+}
+
+TEST(CzmFaceTest, DerivedGeometryFollowsVertexUpdates)
+{
+    static_assert(std::is_trivially_copyable<czm_face::CzmFace>::value, "cached geometry must keep faces memcpy-able");
+
+    czm_face::CzmFace triangle;
+    ASSERT_TRUE(triangle.createFace(kTriangle));
+    double perimeter = triangle.calculatePerimeter();
+    czm_face::BoundingBox box = triangle.calculateBoundingBox();
+    EXPECT_EQ(box.max, Vec3D(2, 1, 1));
+
+    // Repeated queries return the cached values
+    EXPECT_EQ(triangle.calculatePerimeter(), perimeter);
+
+    std::vector<Vec3D> scaled = {2.0 * kTriangle[0], 2.0 * kTriangle[1], 2.0 * kTriangle[2]};
+    ASSERT_TRUE(triangle.updateVertices(scaled));
+    EXPECT_DOUBLE_EQ(triangle.calculatePerimeter(), 2.0 * perimeter);
+    EXPECT_EQ(triangle.calculateBoundingBox().max, Vec3D(4, 2, 2));
+    EXPECT_EQ(triangle.calculateBoundingBox().min, Vec3D(0, 0, 0));
+
+    // Copies made right after an update get the values when they are queried
+    ASSERT_TRUE(triangle.updateVertices(kTriangle));
+    czm_face::CzmFace copy = triangle;
+    triangle.refreshGeometry();
+    EXPECT_EQ(copy.calculatePerimeter(), perimeter);
+    EXPECT_EQ(triangle.calculatePerimeter(), perimeter);
+}
@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "vec3d/vec3d.h"
+
+// Operators are usable in constant expressions
+static_assert(Vec3d(1, 0, 0).cross(Vec3d(0, 1, 0)) == Vec3d(0, 0, 1), "constexpr cross");
+static_assert(dot(Vec3d(1, 2, 3), Vec3d(4, 5, 6)) == 32.0, "constexpr dot");
+static_assert((2 * Vec3f(1, 2, 3) - Vec3f(1, 1, 1)) == Vec3f(1, 3, 5), "constexpr float arithmetic");
+
+TEST(Vec3Test, LegacyVec3DInterface)
+{
+    const Vec3D a(1, 2, 3);
+    const Vec3D b(4, 5, 6);
+
+    // Former non-const members now work on const operands
+    EXPECT_DOUBLE_EQ(a.dot(b), 32.0);
+    EXPECT_TRUE(a.cross(b) == Vec3D(-3, 6, -3));
+    EXPECT_TRUE((a + b) / 2.0 == Vec3D(2.5, 3.5, 4.5));
+    EXPECT_TRUE(a * 2 == Vec3D(2, 4, 6));
+    EXPECT_TRUE(-a == Vec3D(-1, -2, -3));
+    EXPECT_DOUBLE_EQ(fabs(Vec3D(3, 4, 0)), 5.0);
+    EXPECT_DOUBLE_EQ(Vec3D(0, 0, 2).norm()[2], 1.0);
+
+    Vec3D c;
+    c = 1.5;
+    EXPECT_TRUE(c == Vec3D(1.5, 1.5, 1.5));
+    c = std::vector<double>{7, 8, 9};
+    c -= Vec3D(1, 1, 1);
+    EXPECT_TRUE(c == Vec3D(6, 7, 8));
+}
+
+TEST(Vec3Test, PrecisionConversion)
+{
+    Vec3f f(Vec3d(0.5, 1.5, -2.0));
+    EXPECT_FLOAT_EQ(f[0], 0.5f);
+    EXPECT_FLOAT_EQ(f[2], -2.0f);
+    EXPECT_TRUE(Vec3d(f) == Vec3d(0.5, 1.5, -2.0));
+}